@@ -0,0 +1,708 @@
+/*
+    Título: Benchmark
+    Nombre: Héctor Paredes Benavides
+    Descripción: Medimos el rendimiento del cifrado y descifrado de Huffman sobre corpus sintéticos reproducibles y ficheros reales
+    Fecha: 16/10/2026
+*/
+
+/* Instrucciones de Preprocesado */
+// Inclusión de bibliotecas externas
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+// Inclusión de bibliotecas propias
+#include "huffman.h"
+
+// Definición de constantes
+#define byte unsigned char
+#define KIBIBYTE 1024
+#define MAX_CORPUS_SIZE (1024LL * 1024 * 1024)
+#define MAX_SIZES_NUMBER 32
+#define MAX_FILES_NUMBER 32
+#define MAX_THREADS_NUMBER 256
+#define DEFAULT_SIZES "1K,64K,1M,16M,256M"
+#define DEFAULT_CORPORA "uniform,zipf,skewed,logs"
+#define DEFAULT_REPETITIONS 3
+#define BENCHMARK_SEED 0x48554646ULL
+#define MEGABYTE 1e6
+
+// Corpus sintéticos
+#define CORPUS_UNIFORM 0
+#define CORPUS_ZIPF 1
+#define CORPUS_SKEWED 2
+#define CORPUS_LOGS 3
+#define CORPORA_NUMBER 4
+
+// Parámetros de los corpus
+#define ZIPF_WORDS_NUMBER 4096
+#define ZIPF_MIN_WORD_LENGTH 2
+#define ZIPF_MAX_WORD_LENGTH 10
+#define ZIPF_WORDS_PER_LINE 12
+#define SKEWED_UNIFORM_ONE_IN 16
+
+/* Declaraciones Globales */
+// Estructuras
+typedef struct BenchmarkResult_s{
+
+    int status;
+    long long compressedSize;
+    double encodeTime;
+    double decodeTime;
+    HuffmanStageTimes_s stageTimes;
+
+}BenchmarkResult_s;
+
+typedef struct Random_s{
+
+    unsigned long long state;
+
+}Random_s;
+
+// Nombres de los corpus (En el mismo orden que sus constantes)
+const char *corporaNames[CORPORA_NUMBER] = {"uniform", "zipf", "skewed", "logs"};
+
+// Prototipado de Funciones
+// Funciones de medición
+void runBenchmark(int corpus, char *fileName, long long size, int repetitions, int blockSize, int maxCodeLength, int streamsNumber, int threadsNumber, BenchmarkResult_s *result);
+void printBenchmarkResult(const char *corpusName, long long size, BenchmarkResult_s *result, long peakRss, int isFirst);
+void printStage(char *stageName, double seconds, long long size, int isLast);
+double getTime();
+
+// Funciones de los corpus
+void generateCorpus(int corpus, byte *content, long long size);
+void generateUniform(Random_s *random, byte *content, long long size);
+void generateZipf(Random_s *random, byte *content, long long size);
+void generateSkewed(Random_s *random, byte *content, long long size);
+void generateLogs(Random_s *random, byte *content, long long size);
+unsigned long long nextRandom(Random_s *random);
+long long getCorpusFileSize(char *fileName);
+int loadCorpusFile(char *fileName, byte *content, long long size);
+
+// Funciones auxiliares
+int parseSizes(char *sizesList, long long *sizes);
+int parseCorpora(char *corporaList, int *corpora);
+void printJsonString(const char *string);
+
+/* Función Principal Main */
+int main(int argc, char **argv){
+
+    // Variables necesarias
+    char *sizesList = DEFAULT_SIZES;
+    char *corporaList = DEFAULT_CORPORA;
+    long long sizes[MAX_SIZES_NUMBER];
+    int sizesNumber = 0;
+    int corpora[CORPORA_NUMBER];
+    int corporaNumber = 0;
+    char *fileNames[MAX_FILES_NUMBER];
+    long long fileSizes[MAX_FILES_NUMBER];
+    int filesNumber = 0;
+    int measuresNumber = 0;
+    int isFile = 0;
+    int corpus = 0;
+    char *fileName = NULL;
+    long long size = 0;
+    const char *corpusName = NULL;
+    int repetitions = DEFAULT_REPETITIONS;
+    int blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE;
+    int maxCodeLength = HUFFMAN_DEFAULT_MAX_CODE_LENGTH;
+    int streamsNumber = HUFFMAN_DEFAULT_STREAMS_NUMBER;
+    int threadsNumber = 1;
+    int resultPipe[2];
+    pid_t child = 0;
+    int childStatus = 0;
+    struct rusage childUsage;
+    BenchmarkResult_s result;
+    int isFirst = 1;
+    int failed = 0;
+
+    // Leemos las opciones de la línea de comandos
+    for(int i = 1; i < argc; i++){
+
+        // Tamaños de los corpus separados por comas (Con sufijos K, M y G)
+        if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            sizesList = argv[++i];
+        // Corpus separados por comas
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            corporaList = argv[++i];
+        // Repeticiones de cada medida (Nos quedamos con la más rápida)
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repetitions = atoi(argv[++i]);
+        // Tamaño de bloque en KiB
+        else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            blockSize = atoi(argv[++i]) * KIBIBYTE;
+        // Longitud máxima de los códigos
+        else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            maxCodeLength = atoi(argv[++i]);
+        // Flujos entrelazados por bloque
+        else if(strcmp(argv[i], "-S") == 0 && i + 1 < argc)
+            streamsNumber = atoi(argv[++i]);
+        // Hilos para el histograma de cada bloque
+        else if(strcmp(argv[i], "-T") == 0 && i + 1 < argc)
+            threadsNumber = atoi(argv[++i]);
+        // Ficheros reales que se miden enteros como un corpus más (Se puede repetir)
+        else if(strcmp(argv[i], "-f") == 0 && i + 1 < argc && filesNumber < MAX_FILES_NUMBER)
+            fileNames[filesNumber++] = argv[++i];
+        else{
+
+            fprintf(stderr, "Uso: %s [-s tamaños] [-c corpus] [-r repeticiones] [-b KiB] [-l bits] [-S flujos] [-T hilos] [-f fichero]...\n", argv[0]);
+            exit(1);
+
+        }
+
+    }
+
+    if((sizesNumber = parseSizes(sizesList, sizes)) <= 0){
+
+        fprintf(stderr, "ERROR: Los tamaños deben estar entre 1 y 1G, por ejemplo '1K,1M,1G'.\n");
+        exit(1);
+
+    }
+
+    // Con ficheros la lista de corpus sintéticos puede estar vacía
+    if((corporaNumber = parseCorpora(corporaList, corpora)) < 0 || (corporaNumber == 0 && filesNumber == 0)){
+
+        fprintf(stderr, "ERROR: Los corpus disponibles son %s.\n", DEFAULT_CORPORA);
+        exit(1);
+
+    }
+
+    // Comprobamos los ficheros antes de empezar el informe, así un nombre mal escrito no deja el JSON a medias
+    for(int i = 0; i < filesNumber; i++){
+
+        if((fileSizes[i] = getCorpusFileSize(fileNames[i])) < 1 || fileSizes[i] > MAX_CORPUS_SIZE){
+
+            fprintf(stderr, "ERROR: El fichero '%s' no se puede leer o no tiene entre 1 byte y 1G.\n", fileNames[i]);
+            exit(1);
+
+        }
+
+    }
+
+    if(repetitions < 1 || blockSize < KIBIBYTE || blockSize > HUFFMAN_MAX_BLOCK_SIZE ||
+       maxCodeLength < HUFFMAN_MIN_CODE_LENGTH_LIMIT || maxCodeLength > HUFFMAN_MAX_CODE_LENGTH_LIMIT ||
+       streamsNumber < 1 || streamsNumber > HUFFMAN_MAX_STREAMS_NUMBER ||
+       threadsNumber < 1 || threadsNumber > MAX_THREADS_NUMBER){
+
+        fprintf(stderr, "ERROR: Los parámetros no son válidos.\n");
+        exit(1);
+
+    }
+
+    // Los parámetros van al principio del informe para poder comparar solo ejecuciones equivalentes
+    printf("{\n");
+    printf("  \"benchmark\": \"huffman\",\n");
+    printf("  \"seed\": %llu,\n", BENCHMARK_SEED);
+    printf("  \"repetitions\": %d,\n", repetitions);
+    printf("  \"blockSize\": %d,\n", blockSize);
+    printf("  \"maxCodeLength\": %d,\n", maxCodeLength);
+    printf("  \"streamsNumber\": %d,\n", streamsNumber);
+    printf("  \"threadsNumber\": %d,\n", threadsNumber);
+    printf("  \"results\": [");
+    fflush(stdout);
+
+    // Cada medida se hace en un proceso hijo, así su pico de memoria no incluye el de las anteriores
+    // Primero van los corpus sintéticos con cada tamaño y después los ficheros, cada uno con su propio tamaño
+    measuresNumber = corporaNumber * sizesNumber + filesNumber;
+
+    for(int i = 0; i < measuresNumber; i++){
+
+        isFile = (i >= corporaNumber * sizesNumber);
+        corpus = isFile ? -1 : corpora[i / sizesNumber];
+        fileName = isFile ? fileNames[i - corporaNumber * sizesNumber] : NULL;
+        size = isFile ? fileSizes[i - corporaNumber * sizesNumber] : sizes[i % sizesNumber];
+        corpusName = isFile ? fileName : corporaNames[corpus];
+
+        if(pipe(resultPipe) != 0 || (child = fork()) < 0){
+
+            fprintf(stderr, "ERROR: No se ha podido crear el proceso de la medida.\n");
+            exit(1);
+
+        }
+
+        if(child == 0){
+
+            close(resultPipe[0]);
+            runBenchmark(corpus, fileName, size, repetitions, blockSize, maxCodeLength, streamsNumber, threadsNumber, &result);
+
+            if(write(resultPipe[1], &result, sizeof(result)) != sizeof(result))
+                _exit(1);
+
+            _exit(0);
+
+        }
+
+        close(resultPipe[1]);
+        memset(&result, 0, sizeof(result));
+        result.status = -1;
+
+        if(read(resultPipe[0], &result, sizeof(result)) != sizeof(result))
+            result.status = -1;
+
+        close(resultPipe[0]);
+        wait4(child, &childStatus, 0, &childUsage);
+
+        if(result.status != 0 || !WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0){
+
+            fprintf(stderr, "ERROR: La medida de '%s' con %lld bytes ha fallado.\n", corpusName, size);
+            failed = 1;
+            continue;
+
+        }
+
+        printBenchmarkResult(corpusName, size, &result, childUsage.ru_maxrss, isFirst);
+        isFirst = 0;
+
+    }
+
+    printf("\n  ]\n}\n");
+
+    return failed;
+
+}
+
+/* Codificación de Funciones */
+// runBenchmark
+void runBenchmark(int corpus, char *fileName, long long size, int repetitions, int blockSize, int maxCodeLength, int streamsNumber, int threadsNumber, BenchmarkResult_s *result){
+
+    // Variables necesarias
+    byte *content = NULL;
+    byte *encodedContent = NULL;
+    byte *decodedContent = NULL;
+    size_t encodedCapacity = 0;
+    HuffmanEncoder_s *encoder = NULL;
+    HuffmanDecoder_s *decoder = NULL;
+    HuffmanStats_s stats;
+    long long encodedLength = 0;
+    long long decodedLength = 0;
+    double startTime = 0;
+    double encodeTime = 0;
+    double decodeTime = 0;
+
+    memset(result, 0, sizeof(BenchmarkResult_s));
+    result->status = -1;
+
+    // Generamos o cargamos el corpus y reservamos todo antes de medir
+    encodedCapacity = huffmanEncodeBound(size, blockSize, maxCodeLength);
+    content = (byte*)malloc(size);
+    encodedContent = (byte*)malloc(encodedCapacity);
+    decodedContent = (byte*)malloc(size);
+    encoder = huffmanCreateEncoder(blockSize, maxCodeLength, threadsNumber);
+    decoder = huffmanCreateDecoder();
+
+    if(content == NULL || encodedContent == NULL || decodedContent == NULL || encoder == NULL || decoder == NULL)
+        return;
+
+    if(fileName != NULL){
+
+        if(!loadCorpusFile(fileName, content, size))
+            return;
+
+    }
+    else
+        generateCorpus(corpus, content, size);
+
+    huffmanSetEncoderStreams(encoder, streamsNumber);
+    huffmanSetEncoderStats(encoder, &stats);
+    huffmanSetDecoderStats(decoder, &stats);
+
+    // Repetimos la medida y nos quedamos con el mejor tiempo de cada etapa, que es el menos afectado por el ruido de la máquina
+    for(int i = 0; i < repetitions; i++){
+
+        memset(&stats, 0, sizeof(stats));
+
+        startTime = getTime();
+        encodedLength = huffmanEncode(encoder, content, size, encodedContent, encodedCapacity);
+        encodeTime = getTime() - startTime;
+
+        startTime = getTime();
+        decodedLength = huffmanDecode(decoder, encodedContent, encodedLength, decodedContent, size);
+        decodeTime = getTime() - startTime;
+
+        // Una medida solo vale si el descifrado devuelve exactamente el corpus
+        if(encodedLength < 0 || decodedLength != size || memcmp(content, decodedContent, size) != 0)
+            return;
+
+        if(i == 0 || encodeTime < result->encodeTime)
+            result->encodeTime = encodeTime;
+
+        if(i == 0 || decodeTime < result->decodeTime)
+            result->decodeTime = decodeTime;
+
+        if(i == 0 || stats.wallTimes.histogram < result->stageTimes.histogram)
+            result->stageTimes.histogram = stats.wallTimes.histogram;
+
+        if(i == 0 || stats.wallTimes.treeBuild < result->stageTimes.treeBuild)
+            result->stageTimes.treeBuild = stats.wallTimes.treeBuild;
+
+        if(i == 0 || stats.wallTimes.codeGeneration < result->stageTimes.codeGeneration)
+            result->stageTimes.codeGeneration = stats.wallTimes.codeGeneration;
+
+        if(i == 0 || stats.wallTimes.encode < result->stageTimes.encode)
+            result->stageTimes.encode = stats.wallTimes.encode;
+
+        if(i == 0 || stats.wallTimes.decodeTable < result->stageTimes.decodeTable)
+            result->stageTimes.decodeTable = stats.wallTimes.decodeTable;
+
+        if(i == 0 || stats.wallTimes.decode < result->stageTimes.decode)
+            result->stageTimes.decode = stats.wallTimes.decode;
+
+    }
+
+    result->compressedSize = encodedLength;
+    result->status = 0;
+
+    // Liberamos la memoria utilizada
+    huffmanFreeEncoder(encoder);
+    huffmanFreeDecoder(decoder);
+    free(content);
+    free(encodedContent);
+    free(decodedContent);
+
+}
+
+// printBenchmarkResult
+void printBenchmarkResult(const char *corpusName, long long size, BenchmarkResult_s *result, long peakRss, int isFirst){
+
+    // Una línea JSON por medida para que se pueda comparar fácilmente entre ejecuciones (El nombre puede ser una ruta)
+    printf("%s\n    {\"corpus\": ", isFirst ? "" : ",");
+    printJsonString(corpusName);
+    printf(", \"size\": %lld, \"compressedSize\": %lld, \"ratio\": %.4f, ",
+           size, result->compressedSize, (double)size / result->compressedSize);
+    printf("\"encodeMBps\": %.2f, \"decodeMBps\": %.2f, \"peakRssKiB\": %ld, \"stages\": {",
+           size / MEGABYTE / result->encodeTime, size / MEGABYTE / result->decodeTime, peakRss);
+
+    printStage("histogram", result->stageTimes.histogram, size, 0);
+    printStage("treeBuild", result->stageTimes.treeBuild, size, 0);
+    printStage("codeGeneration", result->stageTimes.codeGeneration, size, 0);
+    printStage("encode", result->stageTimes.encode, size, 0);
+    printStage("decodeTable", result->stageTimes.decodeTable, size, 0);
+    printStage("decode", result->stageTimes.decode, size, 1);
+
+    printf("}}");
+    fflush(stdout);
+
+}
+
+// printStage
+void printStage(char *stageName, double seconds, long long size, int isLast){
+
+    // El rendimiento de cada etapa se expresa sobre los bytes del corpus
+    if(seconds > 0)
+        printf("\"%s\": {\"seconds\": %.9f, \"MBps\": %.2f}", stageName, seconds, size / MEGABYTE / seconds);
+    else
+        printf("\"%s\": {\"seconds\": 0, \"MBps\": null}", stageName);
+
+    if(!isLast)
+        printf(", ");
+
+}
+
+// getTime
+double getTime(){
+
+    // Variables necesarias
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+
+}
+
+// generateCorpus
+void generateCorpus(int corpus, byte *content, long long size){
+
+    // Variables necesarias
+    Random_s random;
+
+    // Cada corpus tiene su propia semilla fija, así el mismo tamaño genera siempre los mismos bytes
+    random.state = BENCHMARK_SEED * (corpus + 1);
+
+    switch(corpus){
+
+        case CORPUS_UNIFORM:
+            generateUniform(&random, content, size);
+            break;
+        case CORPUS_ZIPF:
+            generateZipf(&random, content, size);
+            break;
+        case CORPUS_SKEWED:
+            generateSkewed(&random, content, size);
+            break;
+        case CORPUS_LOGS:
+            generateLogs(&random, content, size);
+            break;
+
+    }
+
+}
+
+// generateUniform
+void generateUniform(Random_s *random, byte *content, long long size){
+
+    // Bytes aleatorios uniformes, el peor caso para Huffman
+    for(long long i = 0; i < size; i++)
+        content[i] = nextRandom(random);
+
+}
+
+// generateZipf
+void generateZipf(Random_s *random, byte *content, long long size){
+
+    // Variables necesarias
+    char words[ZIPF_WORDS_NUMBER][ZIPF_MAX_WORD_LENGTH + 1];
+    double cumulative[ZIPF_WORDS_NUMBER];
+    double total = 0;
+    double draw = 0;
+    int wordLength = 0;
+    int first = 0;
+    int last = 0;
+    int middle = 0;
+    long long position = 0;
+    int wordsInLine = 0;
+
+    // Creamos un vocabulario de palabras en minúsculas y sus probabilidades según la ley de Zipf (1 / rango)
+    for(int i = 0; i < ZIPF_WORDS_NUMBER; i++){
+
+        wordLength = ZIPF_MIN_WORD_LENGTH + nextRandom(random) % (ZIPF_MAX_WORD_LENGTH - ZIPF_MIN_WORD_LENGTH + 1);
+
+        for(int j = 0; j < wordLength; j++)
+            words[i][j] = 'a' + nextRandom(random) % 26;
+
+        words[i][wordLength] = '\0';
+        total += 1.0 / (i + 1);
+        cumulative[i] = total;
+
+    }
+
+    // Escribimos palabras elegidas por su probabilidad separadas por espacios y saltos de línea
+    while(position < size){
+
+        draw = (nextRandom(random) >> 11) * (1.0 / 9007199254740992.0) * total;
+        first = 0;
+        last = ZIPF_WORDS_NUMBER - 1;
+
+        while(first < last){
+
+            middle = (first + last) / 2;
+
+            if(cumulative[middle] < draw)
+                first = middle + 1;
+            else
+                last = middle;
+
+        }
+
+        for(int j = 0; words[first][j] != '\0' && position < size; j++)
+            content[position++] = words[first][j];
+
+        if(position < size)
+            content[position++] = (++wordsInLine % ZIPF_WORDS_PER_LINE == 0) ? '\n' : ' ';
+
+    }
+
+}
+
+// generateSkewed
+void generateSkewed(Random_s *random, byte *content, long long size){
+
+    // Variables necesarias
+    unsigned long long value = 0;
+
+    // Valores pequeños con probabilidad geométrica (La mitad son 0, un cuarto 1...) mezclados con algún byte uniforme,
+    // como en muchos ficheros binarios
+    for(long long i = 0; i < size; i++){
+
+        value = nextRandom(random);
+
+        if(value % SKEWED_UNIFORM_ONE_IN == 0)
+            content[i] = value >> 56;
+        else
+            content[i] = (value >> 8) ? __builtin_ctzll(value >> 8) : 0;
+
+    }
+
+}
+
+// generateLogs
+void generateLogs(Random_s *random, byte *content, long long size){
+
+    // Variables necesarias
+    const char *levels[] = {"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+    const char *methods[] = {"GET", "GET", "GET", "POST", "PUT", "DELETE"};
+    const char *paths[] = {"/api/v1/items", "/api/v1/users", "/api/v1/orders", "/health", "/static/app.js"};
+    const int statuses[] = {200, 200, 200, 200, 201, 204, 304, 404, 500};
+    char line[256];
+    int lineLength = 0;
+    long long position = 0;
+    unsigned long long timestamp = 1791331200000ULL;
+    unsigned long long value = 0;
+
+    // Líneas de registro con marca de tiempo creciente y campos con pocos valores distintos
+    while(position < size){
+
+        value = nextRandom(random);
+        timestamp += value % 50;
+
+        lineLength = snprintf(line, sizeof(line), "%llu.%03llu %s [worker-%llu] %s %s/%llu status=%d ip=10.0.%llu.%llu duration_ms=%llu\n",
+                              timestamp / 1000, timestamp % 1000, levels[(value >> 8) % 6], (value >> 12) % 8,
+                              methods[(value >> 16) % 6], paths[(value >> 20) % 5], (value >> 24) % 10000,
+                              statuses[(value >> 40) % 9], (value >> 44) % 4, (value >> 48) % 256, (value >> 56) % 200);
+
+        for(int i = 0; i < lineLength && position < size; i++)
+            content[position++] = line[i];
+
+    }
+
+}
+
+// nextRandom
+unsigned long long nextRandom(Random_s *random){
+
+    // Generador xorshift64*, pequeño y con la misma secuencia en cualquier máquina
+    random->state ^= random->state >> 12;
+    random->state ^= random->state << 25;
+    random->state ^= random->state >> 27;
+
+    return random->state * 0x2545F4914F6CDD1DULL;
+
+}
+
+// getCorpusFileSize
+long long getCorpusFileSize(char *fileName){
+
+    // Variables necesarias
+    FILE *file = NULL;
+    long long size = -1;
+
+    // Solo valen ficheros en los que se pueda buscar el final, el hijo los vuelve a leer para cada medida
+    if((file = fopen(fileName, "rb")) == NULL)
+        return -1;
+
+    if(fseeko(file, 0, SEEK_END) == 0)
+        size = ftello(file);
+
+    fclose(file);
+
+    return size;
+
+}
+
+// loadCorpusFile
+int loadCorpusFile(char *fileName, byte *content, long long size){
+
+    // Variables necesarias
+    FILE *file = NULL;
+    size_t readBytes = 0;
+
+    // El fichero tiene que seguir teniendo el tamaño que vimos al empezar
+    if((file = fopen(fileName, "rb")) == NULL)
+        return 0;
+
+    readBytes = fread(content, 1, size, file);
+    fclose(file);
+
+    return readBytes == (size_t)size;
+
+}
+
+// parseSizes
+int parseSizes(char *sizesList, long long *sizes){
+
+    // Variables necesarias
+    int sizesNumber = 0;
+    char *end = NULL;
+    long long size = 0;
+
+    // Leemos los tamaños separados por comas, cada uno con un sufijo opcional K, M o G (Potencias de 1024)
+    while(*sizesList != '\0'){
+
+        size = strtoll(sizesList, &end, 10);
+
+        if(*end == 'K' || *end == 'k')
+            size *= KIBIBYTE;
+        else if(*end == 'M' || *end == 'm')
+            size *= KIBIBYTE * KIBIBYTE;
+        else if(*end == 'G' || *end == 'g')
+            size *= KIBIBYTE * KIBIBYTE * KIBIBYTE;
+
+        if(end != sizesList && strchr("KkMmGg", *end) != NULL && *end != '\0')
+            end++;
+
+        if(end == sizesList || size < 1 || size > MAX_CORPUS_SIZE || sizesNumber == MAX_SIZES_NUMBER || (*end != ',' && *end != '\0'))
+            return -1;
+
+        sizes[sizesNumber++] = size;
+        sizesList = (*end == ',') ? end + 1 : end;
+
+    }
+
+    return sizesNumber;
+
+}
+
+// parseCorpora
+int parseCorpora(char *corporaList, int *corpora){
+
+    // Variables necesarias
+    int corporaNumber = 0;
+    size_t nameLength = 0;
+    int found = 0;
+
+    // Buscamos cada nombre de la lista entre los corpus disponibles
+    while(*corporaList != '\0'){
+
+        nameLength = strcspn(corporaList, ",");
+        found = 0;
+
+        for(int i = 0; i < CORPORA_NUMBER && !found; i++){
+
+            if(strlen(corporaNames[i]) == nameLength && strncmp(corporaList, corporaNames[i], nameLength) == 0 && corporaNumber < CORPORA_NUMBER){
+
+                corpora[corporaNumber++] = i;
+                found = 1;
+
+            }
+
+        }
+
+        if(!found)
+            return -1;
+
+        corporaList += nameLength;
+
+        if(*corporaList == ',')
+            corporaList++;
+
+    }
+
+    return corporaNumber;
+
+}
+
+// printJsonString
+void printJsonString(const char *string){
+
+    // Escapamos las comillas, las barras y los caracteres de control para que el informe siga siendo JSON válido
+    putchar('"');
+
+    for(; *string != '\0'; string++){
+
+        if(*string == '"' || *string == '\\')
+            printf("\\%c", *string);
+        else if((unsigned char)*string < 0x20)
+            printf("\\u%04x", (unsigned char)*string);
+        else
+            putchar(*string);
+
+    }
+
+    putchar('"');
+
+}
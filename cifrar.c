@@ -12,857 +12,1895 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/resource.h>
+
+// Inclusión de bibliotecas propias
+#include "huffman.h"
+#include "entradaSalida.h"
 
 // Definición de constantes
-#define HASH_TABLE_SIZE 39
-#define BITS_IN_BYTE 8
-#define FREQUENCY_TABLE_FILE "frequency.txt"
-#define TREE_FILE "tree.txt"
-#define HUFFMAN_CODES_FILE "codes.txt"
+#define byte unsigned char
+#define KIBIBYTE 1024
+#define MAX_BLOCK_SIZE_KIB (HUFFMAN_MAX_BLOCK_SIZE / KIBIBYTE)
+#define MAX_THREADS_NUMBER 256
+#define JOBS_PER_THREAD 2
 #define ENCODED_FILE "compressed.bin"
+#define ENCODED_EXTENSION ".huff"
+#define TRAINING_BUFFER_SIZE (1024 * 1024)
 
-#define byte char
+// Estados de los trabajos de bloque
+#define JOB_EMPTY 0
+#define JOB_PENDING 1
+#define JOB_DONE 2
 
 /* Declaraciones Globales */
 // Estructuras
-typedef struct FileLine_s{
+typedef struct BlockJob_s{
 
-    int lineLength;
-    char *lineContent;
+    byte *blockContent;
+    int blockLength;
+    byte *inputBuffer;
+    HuffmanEncoder_s *encoder;
+    byte *encodedBlock;
+    size_t encodedBlockCapacity;
+    long long encodedBlockLength;
+    int state;
+    HuffmanStats_s stats;
 
-}FileLine_s;
+}BlockJob_s;
 
-typedef struct FileContent_s{
+typedef struct ThreadPool_s{
 
-    int linesNumber;
-    FileLine_s *fileLines;
+    pthread_t *threads;
+    int threadsNumber;
+    BlockJob_s **pendingJobs;
+    int pendingJobsCapacity;
+    int pendingJobsStart;
+    int pendingJobsNumber;
+    int finish;
+    pthread_mutex_t mutex;
+    pthread_cond_t jobReady;
+    pthread_cond_t jobDone;
 
-}FileContent_s;
+}ThreadPool_s;
 
-typedef struct HashTable_s{
+typedef struct BlockIndex_s{
 
-    char key;
-    unsigned int value;
+    HuffmanBlockIndexEntry_s *entries;
+    int entriesNumber;
+    int capacity;
 
-}HashTable_s;
+}BlockIndex_s;
 
-typedef struct StringCharacter_s{
+typedef struct FileList_s{
 
-    char character;
-    int frequency;
+    char **fileNames;
+    int fileNamesNumber;
+    int capacity;
 
-}StringCharacter_s;
+}FileList_s;
 
-typedef struct LinkedListNode_s{
+typedef struct BatchFile_s{
 
-    StringCharacter_s stringCharacter;
-    struct LinkedListNode_s *nextNode;
-    struct LinkedListNode_s *backNode;
+    char *fileName;
+    InputFile_s inputFile;
+    FILE *encodedFile;
+    int blocksNumber;
+    int nextBlockToWrite;
+    byte **pendingBlocks;
+    long long *pendingBlocksLength;
+    BlockIndex_s blockIndex;
+    long long encodedFileLength;
+    long long decodedFileLength;
+    pthread_mutex_t mutex;
 
-}LinkedListNode_s;
+}BatchFile_s;
 
-typedef struct TreeNode_s{
+typedef struct BatchTask_s{
 
-    StringCharacter_s stringCharacter;
-    struct TreeNode_s *parentNode;
-    struct TreeNode_s *leftChild;
-    struct TreeNode_s *rightChild;
+    char *fileName;
+    BatchFile_s *batchFile;
+    int blockNumber;
 
-}TreeNode_s;
+}BatchTask_s;
 
-typedef struct HuffmanCode_s{
+typedef struct TaskDeque_s{
 
-    char character;
-    char *code;
-    int codeLength;
+    BatchTask_s *tasks;
+    int top;
+    int bottom;
+    int capacity;
+    pthread_mutex_t mutex;
 
-}HuffmanCode_s;
+}TaskDeque_s;
+
+typedef struct BatchPool_s{
+
+    TaskDeque_s *taskDeques;
+    int workersNumber;
+    int blockSize;
+    int maxCodeLength;
+    int pendingTasksNumber;
+    unsigned long long pushedTasksNumber;
+    int failedFilesNumber;
+    long long encodedTotalLength;
+    long long decodedTotalLength;
+    HuffmanStats_s *stats;
+    pthread_mutex_t mutex;
+    pthread_cond_t taskAdded;
+
+}BatchPool_s;
+
+typedef struct BatchWorker_s{
+
+    BatchPool_s *batchPool;
+    int workerNumber;
+    pthread_t thread;
+    HuffmanEncoder_s *encoder;
+    byte *encodedBlock;
+    size_t encodedBlockCapacity;
+    BlockIndex_s blockIndex;
+    HuffmanStats_s stats;
+
+}BatchWorker_s;
 
 // Prototipado de Funciones
-// Funciones Lista Enlazada
-LinkedListNode_s* initLinkedListFromFrequencyTable(HashTable_s *frequencyTable);
-void insertElementInPriorityQueue(LinkedListNode_s **queue, char character, int frequency);
-void printLinkedList(char *fileName, LinkedListNode_s *linkedList);
-void freeLinkedList(LinkedListNode_s *linkedList);
-
-// Funciones Árboles
-TreeNode_s* initTreeFromPriorityQueue(LinkedListNode_s *queue);
-TreeNode_s* buildTree(TreeNode_s **nodes, int nodesLength);
-TreeNode_s* findMinNode(TreeNode_s **nodes, int *nodesLength);
-void printTree(FILE *file, TreeNode_s *tree);
-void freeTree(TreeNode_s *tree);
-
-// Funciones algoritmo de Huffman
-HuffmanCode_s* initHuffmanCodes();
-void generateHuffmanCodes(HuffmanCode_s **huffmanCodes, TreeNode_s *huffmanTree, int *currentCode, int depth, int *maxDepth);
-void printHuffmanCodes(char *fileName, LinkedListNode_s *charactersList, HuffmanCode_s *huffmanCodes);
-byte* encodeFileContent(FileContent_s fileContent, HuffmanCode_s *huffmanCodes, int maxCodeLength, int *bytesLength);
-void printEncodedFileContent(char *fileName, byte *encodedFileContent, int length);
-
-// Funciones tabla hash
-HashTable_s* initHashTable();
-int getHash(char key);
+// Funciones de salida
+void printEncodedBlock(FILE *file, byte *encodedBlock, long long length);
+
+// Funciones de bloques en paralelo
+void compressBlock(BlockJob_s *blockJob);
+void printBlockJob(BlockJob_s *blockJob, OutputWriter_s *outputWriter);
+ThreadPool_s* initThreadPool(int threadsNumber, int jobsNumber);
+void submitBlockJob(ThreadPool_s *threadPool, BlockJob_s *blockJob);
+void waitBlockJob(ThreadPool_s *threadPool, BlockJob_s *blockJob);
+void* threadPoolWorker(void *arg);
+void freeThreadPool(ThreadPool_s *threadPool);
+
+// Funciones del índice de bloques
+void addBlockIndexEntry(BlockIndex_s *blockIndex, long long compressedOffset, long long decodedOffset);
+long long printBlockIndex(FILE *file, BlockIndex_s *blockIndex, long long encodedFileLength);
+
+// Funciones del formato del contenedor
+void printContainerHeader(FILE *file, unsigned long long originalSize, int options);
+
+// Funciones del modo adaptativo
+long long compressAdaptively(char *fileName, FILE *encodedFile, int chunkSize, int maxCodeLength, HuffmanStats_s *stats);
+
+// Funciones de las tablas estáticas
+int loadStaticTable(char *tableName, byte *codeLengths);
+void trainStaticTable(FileList_s *fileList, char *tableFileName, int tableId, int maxCodeLength);
+
+// Funciones del modo por lotes
+void addFileName(FileList_s *fileList, char *fileName);
+int readFileList(FileList_s *fileList, char *listName);
+int walkDirectory(FileList_s *fileList, char *directoryName);
+void freeFileList(FileList_s *fileList);
+int compressBatch(FileList_s *fileList, char *fileListName, int threadsNumber, int blockSize, int maxCodeLength, int streamsNumber, int contextOrder, int *transforms, int transformsNumber, int lzLevel, int windowBits, int checkpointInterval, int staticTableId, byte *staticCodeLengths, HuffmanStats_s *stats);
+void* batchWorker(void *arg);
+int getBatchTask(BatchWorker_s *batchWorker, BatchTask_s *batchTask);
+void pushBatchTask(BatchPool_s *batchPool, int workerNumber, BatchTask_s batchTask);
+void finishBatchTask(BatchPool_s *batchPool);
+int popBatchTask(TaskDeque_s *taskDeque, BatchTask_s *batchTask);
+int stealBatchTask(TaskDeque_s *taskDeque, BatchTask_s *batchTask);
+void compressBatchFile(BatchWorker_s *batchWorker, char *fileName);
+void compressBatchBlock(BatchWorker_s *batchWorker, BatchFile_s *batchFile, int blockNumber);
+void writeBatchBlock(BatchFile_s *batchFile, byte *encodedBlock, long long encodedBlockLength, int blockSize);
+void finishBatchFile(BatchWorker_s *batchWorker, BatchFile_s *batchFile);
+void failBatchFile(BatchPool_s *batchPool, char *message, char *fileName);
+
+// Funciones de estadísticas
+void printStats(HuffmanStats_s *stats, double wallTime, char *statsFileName);
+
+// Funciones auxiliares
+char* readLine(int *length);
+FILE* openFile(char *fileName, char *mode);
+int parseTransforms(char *transformsList, int *transforms);
+
+/* Función Principal Main*/
+int main(int argc, char **argv){
+
+    // Variables necesarias
+    char *fileName = NULL;
+    int fileNameLength = 0;
+    InputFile_s inputFile;
+    char *encodedFileName = NULL;
+    FILE *encodedFile = NULL;
+    unsigned long long originalSize = HUFFMAN_UNKNOWN_ORIGINAL_SIZE;
+    size_t blockLength = 0;
+    int blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE;
+    int maxCodeLengthLimit = HUFFMAN_DEFAULT_MAX_CODE_LENGTH;
+    int streamsNumber = HUFFMAN_DEFAULT_STREAMS_NUMBER;
+    int contextOrder = 0;
+    int transforms[HUFFMAN_MAX_TRANSFORMS_NUMBER];
+    int transformsNumber = 0;
+    int lzLevel = 0;
+    int windowBits = HUFFMAN_DEFAULT_WINDOW_BITS;
+    int checkpointInterval = 0;
+    long long encodedFileLength = 0;
+    long long decodedFileLength = 0;
+    BlockIndex_s blockIndex = {NULL, 0, 0};
+    int threadsNumber = 1;
+    ThreadPool_s *threadPool = NULL;
+    OutputWriter_s *outputWriter = NULL;
+    BlockJob_s *blockJobs = NULL;
+    int jobsNumber = 0;
+    int currentJob = 0;
+    size_t blocksTotalNumber = 0;
+    int histogramThreadsNumber = 1;
+    FileList_s fileList = {NULL, 0, 0};
+    char *fileListName = NULL;
+    struct stat fileStat;
+    int failedFilesNumber = 0;
+    int statsEnabled = 0;
+    char *statsFileName = NULL;
+    int isAdaptive = 0;
+    char *staticTableName = NULL;
+    int staticTableId = 0;
+    byte staticCodeLengths[HUFFMAN_SYMBOLS_NUMBER];
+    char *trainedTableFileName = NULL;
+    int trainedTableId = HUFFMAN_FIRST_USER_TABLE_ID;
+    HuffmanEncoder_s *tableEncoder = NULL;
+    HuffmanStats_s programStats;
+    HuffmanStats_s *stats = NULL;
+    HuffmanStageClock_s programClock;
+    HuffmanStageClock_s stageClock;
+    double wallTime = 0;
+
+    huffmanMeasureStage(&programClock, NULL, NULL);
+
+    // Leemos las opciones de la línea de comandos
+    for(int i = 1; i < argc; i++){
+
+        // Longitud máxima de los códigos
+        if(strcmp(argv[i], "-l") == 0 && i + 1 < argc){
+
+            maxCodeLengthLimit = atoi(argv[++i]);
+
+            if(maxCodeLengthLimit < HUFFMAN_MIN_CODE_LENGTH_LIMIT || maxCodeLengthLimit > HUFFMAN_MAX_CODE_LENGTH_LIMIT){
+
+                printf("ERROR: La longitud máxima de código debe estar entre %d y %d bits.\n", HUFFMAN_MIN_CODE_LENGTH_LIMIT, HUFFMAN_MAX_CODE_LENGTH_LIMIT);
+                exit(1);
+
+            }
+
+        }
+        // Tamaño de bloque en KiB
+        else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc){
+
+            blockSize = atoi(argv[++i]);
+
+            if(blockSize < 1 || blockSize > MAX_BLOCK_SIZE_KIB){
+
+                printf("ERROR: El tamaño de bloque debe estar entre 1 y %d KiB.\n", MAX_BLOCK_SIZE_KIB);
+                exit(1);
+
+            }
+
+            blockSize *= KIBIBYTE;
+
+        }
+        // Número de flujos entrelazados en los que se reparte cada bloque
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc){
+
+            streamsNumber = atoi(argv[++i]);
+
+            if(streamsNumber < 1 || streamsNumber > HUFFMAN_MAX_STREAMS_NUMBER){
+
+                printf("ERROR: El número de flujos debe estar entre 1 y %d.\n", HUFFMAN_MAX_STREAMS_NUMBER);
+                exit(1);
+
+            }
+
+        }
+        // Orden del contexto: 0 para una única tabla por bloque, 1 para una tabla por cada byte anterior
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc){
+
+            contextOrder = atoi(argv[++i]);
+
+            if(contextOrder < 0 || contextOrder > HUFFMAN_MAX_CONTEXT_ORDER){
+
+                printf("ERROR: El orden del contexto debe estar entre 0 y %d.\n", HUFFMAN_MAX_CONTEXT_ORDER);
+                exit(1);
+
+            }
+
+        }
+        // Transformaciones que se aplican a cada bloque antes de cifrarlo, separadas por comas ("rle", "bwt" y "mtf")
+        else if(strcmp(argv[i], "-P") == 0 && i + 1 < argc)
+            transformsNumber = parseTransforms(argv[++i], transforms);
+        // Nivel de LZ77 (0 sin coincidencias, de 1 a 9 más lento y con mejor compresión)
+        else if(strcmp(argv[i], "-z") == 0 && i + 1 < argc){
+
+            lzLevel = atoi(argv[++i]);
+
+            if(lzLevel < 0 || lzLevel > HUFFMAN_MAX_LZ77_LEVEL){
+
+                printf("ERROR: El nivel de LZ77 debe estar entre 0 y %d.\n", HUFFMAN_MAX_LZ77_LEVEL);
+                exit(1);
+
+            }
+
+        }
+        // Bits de la ventana de LZ77 (Distancia máxima de una coincidencia)
+        else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc){
+
+            windowBits = atoi(argv[++i]);
+
+            if(windowBits < HUFFMAN_MIN_WINDOW_BITS || windowBits > HUFFMAN_MAX_WINDOW_BITS){
+
+                printf("ERROR: La ventana de LZ77 debe tener entre %d y %d bits.\n", HUFFMAN_MIN_WINDOW_BITS, HUFFMAN_MAX_WINDOW_BITS);
+                exit(1);
+
+            }
+
+        }
+        // Intervalo de los puntos de acceso en KiB (0 sin puntos de acceso)
+        else if(strcmp(argv[i], "-k") == 0 && i + 1 < argc){
+
+            checkpointInterval = atoi(argv[++i]);
+
+            if(checkpointInterval < 0 || checkpointInterval > MAX_BLOCK_SIZE_KIB){
+
+                printf("ERROR: El intervalo de los puntos de acceso debe estar entre 0 y %d KiB.\n", MAX_BLOCK_SIZE_KIB);
+                exit(1);
+
+            }
+
+            checkpointInterval *= KIBIBYTE;
+
+        }
+        // Número de hilos (0 para usar todos los procesadores disponibles)
+        else if(strcmp(argv[i], "-T") == 0 && i + 1 < argc){
+
+            threadsNumber = atoi(argv[++i]);
+
+            if(threadsNumber == 0)
+                threadsNumber = sysconf(_SC_NPROCESSORS_ONLN);
+
+            if(threadsNumber < 1 || threadsNumber > MAX_THREADS_NUMBER){
+
+                printf("ERROR: El número de hilos debe estar entre 1 y %d (0 para usar todos los procesadores).\n", MAX_THREADS_NUMBER);
+                exit(1);
+
+            }
+
+        }
+        // Modo adaptativo: cifra según llega la entrada, sin bloques ni índice
+        else if(strcmp(argv[i], "-a") == 0)
+            isAdaptive = 1;
+        // Tabla estática para todos los bloques ("texto", "registros" o un fichero de tabla entrenada)
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            staticTableName = argv[++i];
+        // Entrena una tabla estática con las entradas y la guarda en el fichero indicado, sin cifrar nada
+        else if(strcmp(argv[i], "-E") == 0 && i + 1 < argc)
+            trainedTableFileName = argv[++i];
+        // Identificador de la tabla entrenada
+        else if(strcmp(argv[i], "-i") == 0 && i + 1 < argc){
+
+            trainedTableId = atoi(argv[++i]);
+
+            if(trainedTableId < HUFFMAN_FIRST_USER_TABLE_ID || trainedTableId > HUFFMAN_MAX_TABLE_ID){
+
+                printf("ERROR: El identificador de la tabla debe estar entre %d y %d.\n", HUFFMAN_FIRST_USER_TABLE_ID, HUFFMAN_MAX_TABLE_ID);
+                exit(1);
+
+            }
+
+        }
+        // Fichero cifrado de salida ("-" para la salida estándar)
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            encodedFileName = argv[++i];
+        // Lista de ficheros a cifrar por lotes, uno por línea ("-" para la entrada estándar)
+        else if(strcmp(argv[i], "-L") == 0 && i + 1 < argc)
+            fileListName = argv[++i];
+        // Estadísticas en JSON por la salida de errores o, con "--stats=fichero", en un fichero
+        else if(strcmp(argv[i], "--stats") == 0)
+            statsEnabled = 1;
+        else if(strncmp(argv[i], "--stats=", strlen("--stats=")) == 0){
+
+            statsEnabled = 1;
+            statsFileName = argv[i] + strlen("--stats=");
+
+        }
+        // Ficheros o directorios a cifrar ("-" para la entrada estándar)
+        else if(argv[i][0] != '-' || argv[i][1] == '\0')
+            addFileName(&fileList, argv[i]);
+        else{
+
+            printf("Uso: %s [-l bits] [-b KiB] [-s flujos] [-c orden] [-P transformaciones] [-z nivel] [-w bits] [-k KiB] [-T hilos] [-a] [-t tabla] [-o salida] [-L lista] [--stats[=fichero]] [fichero | ficheros y directorios...]\n", argv[0]);
+            printf("     %s -E tabla [-i id] [-l bits] [ficheros...]\n", argv[0]);
+            exit(1);
+
+        }
+
+    }
+
+    // Para entrenar una tabla solo contamos los bytes de las muestras (Sin ficheros, la entrada estándar)
+    if(trainedTableFileName != NULL){
+
+        trainStaticTable(&fileList, trainedTableFileName, trainedTableId, maxCodeLengthLimit);
+        freeFileList(&fileList);
+
+        return 0;
+
+    }
+
+    // Comprobamos la tabla estática antes de abrir ningún fichero de salida
+    if(staticTableName != NULL){
+
+        if(isAdaptive){
+
+            printf("ERROR: El modo adaptativo calcula sus propios códigos, no se puede usar con -t.\n");
+            exit(1);
+
+        }
+
+        if(contextOrder > 0 || lzLevel > 0){
+
+            printf("ERROR: Con -t todos los bloques usan la tabla estática, no se puede usar con -c ni con -z.\n");
+            exit(1);
+
+        }
+
+        staticTableId = loadStaticTable(staticTableName, staticCodeLengths);
+        tableEncoder = huffmanCreateEncoder(blockSize, maxCodeLengthLimit, 1);
+
+        if(huffmanSetEncoderStaticTable(tableEncoder, staticTableId, staticCodeLengths) < 0){
+
+            printf("ERROR: La tabla '%s' no es válida o tiene códigos de más de %d bits.\n", staticTableName, maxCodeLengthLimit);
+            exit(1);
+
+        }
+
+        huffmanFreeEncoder(tableEncoder);
+
+    }
+
+    // Para empezar a descifrar en cualquier punto de acceso los bloques van en un único flujo, sin coincidencias ni transformaciones
+    if(checkpointInterval > 0 && (streamsNumber > 1 || lzLevel > 0 || transformsNumber > 0)){
+
+        printf("ERROR: Los bloques con puntos de acceso van en un único flujo, no se puede usar -k con -s, -z ni -P.\n");
+        exit(1);
+
+    }
+
+    if(statsEnabled){
+
+        memset(&programStats, 0, sizeof(programStats));
+        stats = &programStats;
+
+    }
+
+    // Con varios ficheros, una lista o un directorio ciframos por lotes, cada fichero en su propio '<fichero>.huff'
+    if(fileListName != NULL || fileList.fileNamesNumber > 1 ||
+       (fileList.fileNamesNumber == 1 && stat(fileList.fileNames[0], &fileStat) == 0 && S_ISDIR(fileStat.st_mode))){
+
+        if(encodedFileName != NULL){
+
+            printf("ERROR: En el modo por lotes cada fichero se cifra en '<fichero>%s', no se puede usar -o.\n", ENCODED_EXTENSION);
+            exit(1);
+
+        }
+
+        if(isAdaptive){
+
+            printf("ERROR: El modo adaptativo cifra una única entrada, no se puede usar por lotes.\n");
+            exit(1);
+
+        }
+
+        failedFilesNumber = compressBatch(&fileList, fileListName, threadsNumber, blockSize, maxCodeLengthLimit, streamsNumber, contextOrder, transforms, transformsNumber, lzLevel, windowBits, checkpointInterval, staticTableId, staticCodeLengths, stats);
+        freeFileList(&fileList);
+
+        if(stats != NULL){
+
+            huffmanMeasureStage(&programClock, &wallTime, NULL);
+            printStats(stats, wallTime, statsFileName);
+
+        }
+
+        return (failedFilesNumber > 0) ? 1 : 0;
+
+    }
+
+    if(encodedFileName == NULL)
+        encodedFileName = ENCODED_FILE;
+
+    // En el modo adaptativo ciframos la entrada según llega (Sin fichero, la entrada estándar) con el tamaño de bloque como trozo máximo
+    if(isAdaptive){
+
+        if(contextOrder > 0 || lzLevel > 0){
+
+            printf("ERROR: El modo adaptativo usa una única tabla, no se puede usar con -c ni con -z.\n");
+            exit(1);
+
+        }
+
+        if(streamsNumber > 1){
+
+            printf("ERROR: El modo adaptativo cifra cada trozo en un único flujo, no se puede usar con -s.\n");
+            exit(1);
+
+        }
+
+        if(transformsNumber > 0){
+
+            printf("ERROR: El modo adaptativo no tiene bloques que transformar, no se puede usar con -P.\n");
+            exit(1);
+
+        }
+
+        if(checkpointInterval > 0){
+
+            printf("ERROR: El modo adaptativo no tiene índice, no se puede usar con -k.\n");
+            exit(1);
+
+        }
+
+        fileName = (fileList.fileNamesNumber == 1) ? fileList.fileNames[0] : "-";
+        encodedFile = (strcmp(encodedFileName, "-") == 0) ? stdout : openFile(encodedFileName, "wb");
+        encodedFileLength = compressAdaptively(fileName, encodedFile, blockSize, maxCodeLengthLimit, stats);
+
+        if(encodedFile != stdout)
+            printf("LEN: %lld\n", encodedFileLength);
+
+        if(fclose(encodedFile) != 0){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero cifrado.\n");
+            exit(1);
+
+        }
+
+        if(stats != NULL){
+
+            stats->bytesOut = encodedFileLength;
+            huffmanMeasureStage(&programClock, &wallTime, NULL);
+            printStats(stats, wallTime, statsFileName);
+
+        }
+
+        freeFileList(&fileList);
+
+        return 0;
+
+    }
+
+    // Si no nos han indicado el fichero obtenemos su nombre por teclado
+    if(fileList.fileNamesNumber == 1)
+        fileName = strdup(fileList.fileNames[0]);
+    else{
+
+        printf("Introduzca el nombre del fichero a cifrar: ");
+        fileName = readLine(&fileNameLength);
+
+    }
+
+    // Abrimos el fichero a cifrar (Proyectado en memoria si es posible) y el fichero cifrado
+    measureProgramStage(stats, &stageClock, STAGE_START);
+    inputFile = openInputFile(fileName, blockSize);
+    startInputReader(&inputFile, blockSize);
+    measureProgramStage(stats, &stageClock, STAGE_READ);
+    encodedFile = (strcmp(encodedFileName, "-") == 0) ? stdout : openFile(encodedFileName, "wb");
+
+    // Empezamos el contenedor con su cabecera, si la entrada está proyectada ya conocemos su tamaño
+    if(inputFile.isMapped)
+        originalSize = inputFile.length;
+
+    printContainerHeader(encodedFile, originalSize, 0);
+    encodedFileLength = HUFFMAN_CONTAINER_HEADER_LENGTH;
+    measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+    // Reservamos una única vez los trabajos de bloque, la memoria depende del número de hilos pero no del tamaño del fichero
+    // Con varios hilos mantenemos varios bloques en vuelo por hilo para que ninguno espere a la escritura
+    jobsNumber = (threadsNumber > 1) ? threadsNumber * JOBS_PER_THREAD : 1;
+
+    // Si el fichero tiene menos bloques que hilos sobran hilos en el pool, así que los usamos para el histograma de cada bloque
+    if(inputFile.isMapped && threadsNumber > 1){
+
+        blocksTotalNumber = (inputFile.length + blockSize - 1) / blockSize;
+
+        if(blocksTotalNumber > 0 && blocksTotalNumber < (size_t)threadsNumber)
+            histogramThreadsNumber = threadsNumber / blocksTotalNumber;
+
+    }
+
+    blockJobs = (BlockJob_s*)calloc(jobsNumber, sizeof(BlockJob_s));
+
+    for(int i = 0; i < jobsNumber; i++){
+
+        blockJobs[i].encoder = huffmanCreateEncoder(blockSize, maxCodeLengthLimit, histogramThreadsNumber);
+        huffmanSetEncoderStreams(blockJobs[i].encoder, streamsNumber);
+        huffmanSetEncoderContextOrder(blockJobs[i].encoder, contextOrder);
+        huffmanSetEncoderTransforms(blockJobs[i].encoder, transforms, transformsNumber);
+        huffmanSetEncoderLz77(blockJobs[i].encoder, lzLevel, windowBits);
+        huffmanSetEncoderCheckpoints(blockJobs[i].encoder, checkpointInterval);
+
+        if(staticTableId != 0)
+            huffmanSetEncoderStaticTable(blockJobs[i].encoder, staticTableId, staticCodeLengths);
+
+        blockJobs[i].encodedBlockCapacity = huffmanEncodeBlockBound(blockSize, maxCodeLengthLimit);
+        blockJobs[i].encodedBlock = (byte*)malloc(blockJobs[i].encodedBlockCapacity);
+        blockJobs[i].state = JOB_EMPTY;
+
+        // Cada trabajo anota sus propias estadísticas, así los hilos no escriben en la misma estructura
+        if(stats != NULL)
+            huffmanSetEncoderStats(blockJobs[i].encoder, &blockJobs[i].stats);
+
+        // Si la entrada no está proyectada cada trabajo tiene su propio buffer, que cambia por el que ha llenado el hilo lector
+        if(!inputFile.isMapped)
+            blockJobs[i].inputBuffer = (byte*)malloc(blockSize);
+
+    }
+
+    if(threadsNumber > 1)
+        threadPool = initThreadPool(threadsNumber, jobsNumber);
+
+    // Los bloques cifrados los escribe otro hilo mientras ciframos los siguientes, igual que el hilo lector lee por delante
+    outputWriter = startOutputWriter(encodedFile, huffmanEncodeBlockBound(blockSize, maxCodeLengthLimit));
+
+    // Ciframos el fichero bloque a bloque, cada bloque con su propia tabla de códigos
+    // Los trabajos se recorren en orden circular, de modo que los bloques se escriben en el mismo orden que se leen
+    // y la salida es idéntica sea cual sea el número de hilos
+    while(1){
+
+        // Si el trabajo tiene un bloque anterior esperamos a que termine y lo escribimos
+        if(blockJobs[currentJob].state != JOB_EMPTY){
+
+            waitBlockJob(threadPool, &blockJobs[currentJob]);
+            measureProgramStage(stats, &stageClock, STAGE_START);
+            addBlockIndexEntry(&blockIndex, encodedFileLength, decodedFileLength);
+            printBlockJob(&blockJobs[currentJob], outputWriter);
+            measureProgramStage(stats, &stageClock, STAGE_WRITE);
+            encodedFileLength += blockJobs[currentJob].encodedBlockLength;
+            decodedFileLength += blockJobs[currentJob].blockLength;
+
+        }
+
+        // Leemos el siguiente bloque directamente de las páginas proyectadas o nos quedamos con el buffer del hilo lector
+        measureProgramStage(stats, &stageClock, STAGE_START);
+
+        if(inputFile.isMapped){
+
+            if((blockLength = ensureInputBytes(&inputFile, blockSize)) == 0)
+                break;
+
+            blockJobs[currentJob].blockContent = inputFile.content + inputFile.position;
+            inputFile.position += blockLength;
+            prefetchInputBytes(&inputFile, inputFile.position, blockSize);
+
+        }
+        else{
+
+            if((blockLength = takeInputReaderBuffer(inputFile.reader, &blockJobs[currentJob].inputBuffer)) == 0)
+                break;
+
+            blockJobs[currentJob].blockContent = blockJobs[currentJob].inputBuffer;
+
+        }
+
+        blockJobs[currentJob].blockLength = blockLength;
+        measureProgramStage(stats, &stageClock, STAGE_READ);
+
+        // Con un único hilo comprimimos el bloque directamente, si no lo encolamos en el grupo de hilos
+        if(threadPool == NULL){
+
+            compressBlock(&blockJobs[currentJob]);
+            blockJobs[currentJob].state = JOB_DONE;
+
+        }
+        else
+            submitBlockJob(threadPool, &blockJobs[currentJob]);
+
+        currentJob = (currentJob + 1) % jobsNumber;
+
+    }
+
+    // Escribimos los bloques que quedan en vuelo siguiendo el orden circular
+    for(int i = 1; i < jobsNumber; i++){
+
+        currentJob = (currentJob + 1) % jobsNumber;
+
+        if(blockJobs[currentJob].state != JOB_EMPTY){
+
+            waitBlockJob(threadPool, &blockJobs[currentJob]);
+            measureProgramStage(stats, &stageClock, STAGE_START);
+            addBlockIndexEntry(&blockIndex, encodedFileLength, decodedFileLength);
+            printBlockJob(&blockJobs[currentJob], outputWriter);
+            measureProgramStage(stats, &stageClock, STAGE_WRITE);
+            encodedFileLength += blockJobs[currentJob].encodedBlockLength;
+            decodedFileLength += blockJobs[currentJob].blockLength;
+
+        }
+
+    }
+
+    // Esperamos a que se escriban todos los bloques, el índice ya lo escribimos nosotros
+    measureProgramStage(stats, &stageClock, STAGE_START);
+
+    if(!finishOutputWriter(outputWriter)){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero cifrado.\n");
+        exit(1);
+
+    }
+
+    // Terminamos el fichero con el índice de bloques (Su última entrada marca el final de ambos ficheros)
+    addBlockIndexEntry(&blockIndex, encodedFileLength, decodedFileLength);
+    encodedFileLength += printBlockIndex(encodedFile, &blockIndex, encodedFileLength);
+
+    // Si no conocíamos el tamaño original lo completamos en la cabecera (Solo si la salida admite volver atrás)
+    if(originalSize == HUFFMAN_UNKNOWN_ORIGINAL_SIZE && fseek(encodedFile, 0, SEEK_SET) == 0)
+        printContainerHeader(encodedFile, decodedFileLength, 0);
+
+    if(encodedFile != stdout)
+        printf("LEN: %lld\n", encodedFileLength);
+
+    // Cerramos los ficheros
+    closeInputFile(inputFile);
+
+    if(fclose(encodedFile) != 0){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero cifrado.\n");
+        exit(1);
+
+    }
+
+    measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+    // Juntamos las estadísticas de todos los trabajos con las del programa
+    if(stats != NULL){
+
+        for(int i = 0; i < jobsNumber; i++)
+            huffmanAddStats(stats, &blockJobs[i].stats);
+
+        stats->bytesIn = decodedFileLength;
+        stats->bytesOut = encodedFileLength;
+        huffmanMeasureStage(&programClock, &wallTime, NULL);
+        printStats(stats, wallTime, statsFileName);
+
+    }
+
+    // Liberamos la memoria utilizada
+    if(threadPool != NULL)
+        freeThreadPool(threadPool);
+
+    for(int i = 0; i < jobsNumber; i++){
+
+        huffmanFreeEncoder(blockJobs[i].encoder);
+        free(blockJobs[i].encodedBlock);
+        free(blockJobs[i].inputBuffer);
+
+    }
+
+    free(blockJobs);
+    free(blockIndex.entries);
+    free(fileName);
+    freeFileList(&fileList);
+
+    return 0;
+
+}
+
+/* Codificación de Funciones */
+// printEncodedBlock
+void printEncodedBlock(FILE *file, byte *encodedBlock, long long length){
+
+    // Volcamos el bloque cifrado en el fichero
+    if(fwrite(encodedBlock, 1, length, file) != (size_t)length){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero cifrado.\n");
+        exit(1);
+
+    }
+
+}
+
+// compressBlock
+void compressBlock(BlockJob_s *blockJob){
+
+    // Ciframos el bloque con el contexto del trabajo, que conserva sus tablas entre bloques
+    blockJob->encodedBlockLength = huffmanEncodeBlock(blockJob->encoder, blockJob->blockContent, blockJob->blockLength, blockJob->encodedBlock, blockJob->encodedBlockCapacity);
+
+    if(blockJob->encodedBlockLength < 0){
+
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(blockJob->encodedBlockLength));
+        exit(1);
+
+    }
+
+}
+
+// printBlockJob
+void printBlockJob(BlockJob_s *blockJob, OutputWriter_s *outputWriter){
+
+    // Entregamos el bloque cifrado al hilo escritor, que nos devuelve a cambio un buffer ya escrito
+    queueOutputBuffer(outputWriter, &blockJob->encodedBlock, &blockJob->encodedBlockCapacity, blockJob->encodedBlockLength);
+
+    // Dejamos el trabajo libre
+    blockJob->state = JOB_EMPTY;
+
+}
+
+// initThreadPool
+ThreadPool_s* initThreadPool(int threadsNumber, int jobsNumber){
+
+    // Variables necesarias
+    ThreadPool_s *threadPool = NULL;
+
+    // Inicializamos el grupo de hilos con una cola circular con hueco para todos los trabajos
+    threadPool = (ThreadPool_s*)malloc(sizeof(ThreadPool_s));
+    threadPool->threadsNumber = threadsNumber;
+    threadPool->pendingJobsCapacity = jobsNumber;
+    threadPool->pendingJobs = (BlockJob_s**)malloc(jobsNumber * sizeof(BlockJob_s*));
+    threadPool->pendingJobsStart = 0;
+    threadPool->pendingJobsNumber = 0;
+    threadPool->finish = 0;
+
+    pthread_mutex_init(&threadPool->mutex, NULL);
+    pthread_cond_init(&threadPool->jobReady, NULL);
+    pthread_cond_init(&threadPool->jobDone, NULL);
+
+    // Lanzamos los hilos
+    threadPool->threads = (pthread_t*)malloc(threadsNumber * sizeof(pthread_t));
+
+    for(int i = 0; i < threadsNumber; i++){
+
+        if(pthread_create(&threadPool->threads[i], NULL, threadPoolWorker, threadPool) != 0){
+
+            fprintf(stderr, "ERROR: No se ha podido crear el hilo %d.\n", i);
+            exit(1);
+
+        }
 
-// Funciones auxiliares
-char* readLine(int *length);
-FileContent_s readFileContent(char *fileName);
-FileLine_s readFileLine(FILE *file);
-void freeFileContent(FileContent_s fileContent);
+    }
 
-/* Función Principal Main*/
-int main(int argc, char **argv){
+    return threadPool;
+
+}
+
+// submitBlockJob
+void submitBlockJob(ThreadPool_s *threadPool, BlockJob_s *blockJob){
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    // Añadimos el trabajo al final de la cola y avisamos a un hilo
+    blockJob->state = JOB_PENDING;
+    threadPool->pendingJobs[(threadPool->pendingJobsStart + threadPool->pendingJobsNumber) % threadPool->pendingJobsCapacity] = blockJob;
+    threadPool->pendingJobsNumber++;
+
+    pthread_cond_signal(&threadPool->jobReady);
+    pthread_mutex_unlock(&threadPool->mutex);
+
+}
+
+// waitBlockJob
+void waitBlockJob(ThreadPool_s *threadPool, BlockJob_s *blockJob){
+
+    // Sin grupo de hilos el trabajo ya está terminado
+    if(threadPool == NULL)
+        return;
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    while(blockJob->state != JOB_DONE)
+        pthread_cond_wait(&threadPool->jobDone, &threadPool->mutex);
+
+    pthread_mutex_unlock(&threadPool->mutex);
+
+}
+
+// threadPoolWorker
+void* threadPoolWorker(void *arg){
 
     // Variables necesarias
-    char *fileName = NULL;
-    int fileNameLength = 0;
-    FileContent_s fileContent;
-    HashTable_s *frequencyTable = NULL;
-    LinkedListNode_s *priorityQueue;
-    TreeNode_s *charactersTree = NULL;
-    FILE *treeFile = NULL;
-    HuffmanCode_s *huffmanCodes = NULL;
-    int huffmanCodesMaxLength = 0;
-    byte *encodedFileContent = NULL;
-    int encodedFileContentLength = 0;
+    ThreadPool_s *threadPool = (ThreadPool_s*)arg;
+    BlockJob_s *blockJob = NULL;
 
-    // Obtenemos el nombre del archivo
-    printf("Introduzca el nombre del fichero a cifrar: ");
-    fileName = readLine(&fileNameLength);
+    while(1){
 
-    // Abrimos el fichero y leemos su contenido
-    fileContent = readFileContent(fileName);
+        // Esperamos a que haya algún trabajo en la cola o a que nos pidan terminar
+        pthread_mutex_lock(&threadPool->mutex);
 
-    // Inicializamos la tabla de frecuencias
-    frequencyTable = initHashTable();
+        while(threadPool->pendingJobsNumber == 0 && !threadPool->finish)
+            pthread_cond_wait(&threadPool->jobReady, &threadPool->mutex);
 
-    // Recorremos el contenido del fichero y establecemos la tabla de frecuencias correspondiente
-    for(int i = 0; i < fileContent.linesNumber; i++)
-        for(int j = 0; j < fileContent.fileLines[i].lineLength; j++)
-            frequencyTable[getHash(fileContent.fileLines[i].lineContent[j])].value += 1;
+        if(threadPool->pendingJobsNumber == 0){
 
-    // Obtenemos la tabla de frecuencias en forma de cola de prioridad
-    priorityQueue = initLinkedListFromFrequencyTable(frequencyTable);
+            pthread_mutex_unlock(&threadPool->mutex);
+            break;
 
-    // Imprimimos el contenido de la tabla de frecuencias en el fichero correspondiente
-    printLinkedList(FREQUENCY_TABLE_FILE, priorityQueue);
+        }
 
-    // Creamos el árbol con los nodos de las letras
-    charactersTree = initTreeFromPriorityQueue(priorityQueue);
+        // Sacamos el trabajo más antiguo de la cola
+        blockJob = threadPool->pendingJobs[threadPool->pendingJobsStart];
+        threadPool->pendingJobsStart = (threadPool->pendingJobsStart + 1) % threadPool->pendingJobsCapacity;
+        threadPool->pendingJobsNumber--;
 
-    // Imprimimos el árbol de huffman en el fichero 
-    treeFile = fopen(TREE_FILE, "w");
+        pthread_mutex_unlock(&threadPool->mutex);
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(treeFile == NULL){
+        // Comprimimos el bloque fuera del cerrojo
+        compressBlock(blockJob);
 
-        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
-        exit(1);
+        // Marcamos el trabajo como terminado y avisamos al hilo principal
+        pthread_mutex_lock(&threadPool->mutex);
+        blockJob->state = JOB_DONE;
+        pthread_cond_broadcast(&threadPool->jobDone);
+        pthread_mutex_unlock(&threadPool->mutex);
+
+    }
+
+    return NULL;
+
+}
+
+// freeThreadPool
+void freeThreadPool(ThreadPool_s *threadPool){
+
+    // Pedimos a los hilos que terminen y esperamos por ellos
+    pthread_mutex_lock(&threadPool->mutex);
+    threadPool->finish = 1;
+    pthread_cond_broadcast(&threadPool->jobReady);
+    pthread_mutex_unlock(&threadPool->mutex);
+
+    for(int i = 0; i < threadPool->threadsNumber; i++)
+        pthread_join(threadPool->threads[i], NULL);
+
+    // Liberamos la memoria utilizada
+    pthread_mutex_destroy(&threadPool->mutex);
+    pthread_cond_destroy(&threadPool->jobReady);
+    pthread_cond_destroy(&threadPool->jobDone);
+
+    free(threadPool->threads);
+    free(threadPool->pendingJobs);
+    free(threadPool);
+
+}
+
+// addBlockIndexEntry
+void addBlockIndexEntry(BlockIndex_s *blockIndex, long long compressedOffset, long long decodedOffset){
+
+    // Ampliamos el índice duplicando su capacidad cuando se llena
+    if(blockIndex->entriesNumber == blockIndex->capacity){
+
+        blockIndex->capacity = (blockIndex->capacity > 0) ? blockIndex->capacity * 2 : 64;
+        blockIndex->entries = (HuffmanBlockIndexEntry_s*)realloc(blockIndex->entries, blockIndex->capacity * sizeof(HuffmanBlockIndexEntry_s));
 
     }
 
-    printTree(treeFile, charactersTree);
+    blockIndex->entries[blockIndex->entriesNumber].compressedOffset = compressedOffset;
+    blockIndex->entries[blockIndex->entriesNumber].decodedOffset = decodedOffset;
+    blockIndex->entriesNumber++;
 
-    fclose(treeFile);
+}
 
-    // Creamos la tabla hash para los códigos huffman
-    huffmanCodes = initHuffmanCodes();
-    generateHuffmanCodes(&huffmanCodes, charactersTree, NULL, 0, &huffmanCodesMaxLength);
-    printHuffmanCodes(HUFFMAN_CODES_FILE, priorityQueue, huffmanCodes);
+// printBlockIndex
+long long printBlockIndex(FILE *file, BlockIndex_s *blockIndex, long long encodedFileLength){
 
-    // Obtenemos el contenido del fichero codificado
-    encodedFileContent = encodeFileContent(fileContent, huffmanCodes, huffmanCodesMaxLength, &encodedFileContentLength);
-    printEncodedFileContent(ENCODED_FILE, encodedFileContent, encodedFileContentLength);
+    // Variables necesarias
+    byte *indexBuffer = NULL;
+    long long indexLength = 0;
 
-    /* printf("File Content:\n");
-    for(int i = 0; i < fileContent.linesNumber; i++)
-        printf("Line %d (%d): %s\n", i + 1, fileContent.fileLines[i].lineLength, fileContent.fileLines[i].lineContent);
+    // El índice tiene una entrada más que bloques, la última marca el final de ambos ficheros
+    indexLength = huffmanBlockIndexLength(blockIndex->entriesNumber - 1);
+    indexBuffer = (byte*)malloc(indexLength);
 
-    printf("Tabla de frecuencias:\n");
-    for(int i = 0; i < HASH_TABLE_SIZE; i++)
-        printf("%c -> %d\n", frequencyTable[i].key, frequencyTable[i].value); */
+    huffmanWriteBlockIndex(indexBuffer, blockIndex->entries, blockIndex->entriesNumber - 1, encodedFileLength);
+    printEncodedBlock(file, indexBuffer, indexLength);
 
     // Liberamos la memoria utilizada
-    freeFileContent(fileContent);
-    freeLinkedList(priorityQueue);
-    freeTree(charactersTree);
+    free(indexBuffer);
 
-    free(fileName);
-    free(frequencyTable);
-    free(huffmanCodes);
-    free(encodedFileContent);
+    return indexLength;
 
-    return 0;
+}
+
+// printContainerHeader
+void printContainerHeader(FILE *file, unsigned long long originalSize, int options){
+
+    // Variables necesarias
+    byte header[HUFFMAN_CONTAINER_HEADER_LENGTH];
+
+    huffmanWriteContainerHeader(header, originalSize, options);
+    printEncodedBlock(file, header, HUFFMAN_CONTAINER_HEADER_LENGTH);
 
 }
 
-/* Codificación de Funciones */
-// initLinkedListFromFrequencyTable
-LinkedListNode_s* initLinkedListFromFrequencyTable(HashTable_s *frequencyTable){
+// compressAdaptively
+long long compressAdaptively(char *fileName, FILE *encodedFile, int chunkSize, int maxCodeLength, HuffmanStats_s *stats){
 
     // Variables necesarias
-    LinkedListNode_s *linkedListStart = NULL;
-    int firstInsertion = 1;
+    int inputDescriptor = STDIN_FILENO;
+    HuffmanAdaptiveModel_s *model = NULL;
+    byte *chunk = NULL;
+    byte *encodedChunk = NULL;
+    size_t encodedChunkCapacity = 0;
+    ssize_t chunkLength = 0;
+    long long encodedChunkLength = 0;
+    long long encodedFileLength = 0;
+    byte maxCodeLengthByte = maxCodeLength;
+    HuffmanStageClock_s stageClock;
+
+    // Leemos directamente del descriptor, así cada lectura devuelve lo que haya llegado sin esperar a llenar el buffer
+    if(strcmp(fileName, "-") != 0 && (inputDescriptor = open(fileName, O_RDONLY)) < 0){
+
+        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
+        exit(1);
 
-    // Inicializamos la lista
-    linkedListStart = (LinkedListNode_s*)malloc(sizeof(LinkedListNode_s));
-    linkedListStart->backNode = NULL;
-    linkedListStart->nextNode = NULL;
-    linkedListStart->stringCharacter.character = '\0';
-    linkedListStart->stringCharacter.frequency = 0;
+    }
 
-    // Recorremos la tabla hash de frecuencias y vamos introduciendo los caracteres que aparecen al menos una vez
-    for(int i = 0; i < HASH_TABLE_SIZE; i++){
+    // La memoria solo depende del tamaño máximo de un trozo, no de la longitud de la entrada
+    model = huffmanCreateAdaptiveModel(maxCodeLength);
+    huffmanSetAdaptiveStats(model, stats);
+    encodedChunkCapacity = huffmanAdaptiveChunkBound(chunkSize, maxCodeLength);
+    chunk = (byte*)malloc(chunkSize);
+    encodedChunk = (byte*)malloc(encodedChunkCapacity);
 
-        if(frequencyTable[i].value > 0){
+    // Cabecera con la opción adaptativa y el tamaño original desconocido, seguida de la longitud máxima de código
+    measureProgramStage(stats, &stageClock, STAGE_START);
+    printContainerHeader(encodedFile, HUFFMAN_UNKNOWN_ORIGINAL_SIZE, HUFFMAN_OPTION_ADAPTIVE);
+    printEncodedBlock(encodedFile, &maxCodeLengthByte, 1);
+    encodedFileLength = HUFFMAN_CONTAINER_HEADER_LENGTH + 1;
+    measureProgramStage(stats, &stageClock, STAGE_WRITE);
 
-            if(firstInsertion){
+    // Ciframos cada lectura como un trozo y lo enviamos enseguida, sin mirar nada de lo que viene después
+    do{
 
-                firstInsertion = 0;
+        // Si una señal interrumpe la lectura la repetimos
+        do
+            chunkLength = read(inputDescriptor, chunk, chunkSize);
+        while(chunkLength < 0 && errno == EINTR);
 
-                linkedListStart->stringCharacter.character = frequencyTable[i].key;
-                linkedListStart->stringCharacter.frequency = frequencyTable[i].value;
+        if(chunkLength < 0){
 
-            }
-            else
-                insertElementInPriorityQueue(&linkedListStart, frequencyTable[i].key, frequencyTable[i].value);
+            fprintf(stderr, "ERROR: Ha ocurrido un error al leer el fichero '%s'.\n", fileName);
+            exit(1);
 
         }
 
-    }
-    
-    return linkedListStart;
+        measureProgramStage(stats, &stageClock, STAGE_READ);
 
-}
+        // La lectura vacía es el final de la entrada, que se marca con un trozo sin caracteres
+        encodedChunkLength = huffmanEncodeAdaptiveChunk(model, chunk, chunkLength, encodedChunk, encodedChunkCapacity);
 
-// insertElementInPriorityQueue
-void insertElementInPriorityQueue(LinkedListNode_s **queue, char character, int frequency){
+        if(encodedChunkLength < 0){
 
-    // Variables necesarias
-    LinkedListNode_s *queueCopy = NULL;
-    LinkedListNode_s *newNode = NULL;
+            fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(encodedChunkLength));
+            exit(1);
+
+        }
 
-    // Inicializamos la copia de la lista
-    queueCopy = *queue;
+        measureProgramStage(stats, &stageClock, STAGE_START);
+        printEncodedBlock(encodedFile, encodedChunk, encodedChunkLength);
 
-    // Inicializamos el nuevo nodo
-    newNode = (LinkedListNode_s*)malloc(sizeof(LinkedListNode_s));
-    newNode->stringCharacter.character = character;
-    newNode->stringCharacter.frequency = frequency;
+        if(fflush(encodedFile) != 0){
 
-    // Buscamos la posición en la que insertarlo siguiendo una cola de prioridad ascendente
-    while(queueCopy->nextNode != NULL && queueCopy->stringCharacter.frequency < newNode->stringCharacter.frequency)
-        queueCopy = queueCopy->nextNode;
+            fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero cifrado.\n");
+            exit(1);
 
-    // Si tenemos que insertarlo en el inicio
-    if(queueCopy->backNode == NULL && queueCopy->stringCharacter.frequency >= newNode->stringCharacter.frequency){
+        }
 
-        // Establecemos los vecinos del nuevo nodo
-        newNode->backNode = NULL;
-        newNode->nextNode = queueCopy;
+        measureProgramStage(stats, &stageClock, STAGE_WRITE);
 
-        // Establecemos al nuevo nodo como vecino
-        queueCopy->backNode = newNode;
+        encodedFileLength += encodedChunkLength;
 
-        // Establecemos al nuevo nodo como origen de la lista
-        *queue = newNode;
+        if(stats != NULL)
+            stats->bytesIn += chunkLength;
 
-    }
-    // Si tenemos que insertarlo al final
-    else if(queueCopy->nextNode == NULL && queueCopy->stringCharacter.frequency < newNode->stringCharacter.frequency){
+    }while(chunkLength > 0);
+
+    // Liberamos la memoria utilizada
+    if(inputDescriptor != STDIN_FILENO)
+        close(inputDescriptor);
+
+    huffmanFreeAdaptiveModel(model);
+    free(chunk);
+    free(encodedChunk);
+
+    return encodedFileLength;
+
+}
 
-        // Establecemos los vecinos del nuevo nodo
-        newNode->backNode = queueCopy;
-        newNode->nextNode = NULL;
+// loadStaticTable
+int loadStaticTable(char *tableName, byte *codeLengths){
 
-        // Establecemos al nuevo nodo como vecino
-        queueCopy->nextNode = newNode;
+    // Variables necesarias
+    FILE *tableFile = NULL;
+    byte tableContent[HUFFMAN_STATIC_TABLE_LENGTH];
+    size_t tableLength = 0;
+    long long status = 0;
+    int tableId = 0;
+
+    // Las tablas de la biblioteca se eligen por su nombre
+    if(strcmp(tableName, "texto") == 0)
+        tableId = HUFFMAN_TABLE_TEXT;
+    else if(strcmp(tableName, "registros") == 0)
+        tableId = HUFFMAN_TABLE_LOGS;
+
+    if(tableId != 0){
+
+        huffmanGetBuiltinStaticTable(tableId, codeLengths);
+        return tableId;
 
     }
-    // Si tenemos que insertarlo en el medio
-    else{
 
-        // Establecemos los vecinos del nuevo nodo
-        newNode->backNode = queueCopy->backNode;
-        newNode->nextNode = queueCopy;
+    // Cualquier otro nombre es un fichero de tabla entrenada con -E
+    tableFile = openFile(tableName, "rb");
+    tableLength = fread(tableContent, 1, HUFFMAN_STATIC_TABLE_LENGTH, tableFile);
+    fclose(tableFile);
+
+    if((status = huffmanReadStaticTable(tableContent, tableLength, &tableId, codeLengths)) < 0){
 
-        // Establecemos al nuevo nodo como vecino
-        newNode->backNode->nextNode = newNode;
-        newNode->nextNode->backNode = newNode;
+        printf("ERROR: La tabla '%s' no es válida: %s\n", tableName, huffmanErrorMessage(status));
+        exit(1);
 
     }
 
+    return tableId;
+
 }
 
-// printLinkedList
-void printLinkedList(char *fileName, LinkedListNode_s *linkedList){
+// trainStaticTable
+void trainStaticTable(FileList_s *fileList, char *tableFileName, int tableId, int maxCodeLength){
 
     // Variables necesarias
-    FILE *file = NULL;
-    LinkedListNode_s *linkedListCopy = NULL;
+    unsigned long long symbolCounts[HUFFMAN_SYMBOLS_NUMBER] = {0};
+    byte codeLengths[HUFFMAN_SYMBOLS_NUMBER];
+    byte tableContent[HUFFMAN_STATIC_TABLE_LENGTH];
+    InputFile_s inputFile;
+    size_t length = 0;
+    FILE *tableFile = NULL;
 
-    // Abrimos el fichero
-    file = fopen(fileName, "w");
+    // Contamos los bytes de todas las muestras juntas
+    for(int i = 0; i < ((fileList->fileNamesNumber > 0) ? fileList->fileNamesNumber : 1); i++){
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+        inputFile = openInputFile((fileList->fileNamesNumber > 0) ? fileList->fileNames[i] : "-", TRAINING_BUFFER_SIZE);
 
-        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
-        exit(1);
+        while((length = ensureInputBytes(&inputFile, TRAINING_BUFFER_SIZE)) > 0){
+
+            for(size_t j = 0; j < length; j++)
+                symbolCounts[inputFile.content[inputFile.position + j]]++;
+
+            inputFile.position += length;
+
+        }
+
+        closeInputFile(inputFile);
 
     }
 
-    // Inicializamos la copia de la lista
-    linkedListCopy = linkedList;
+    // La tabla da código a todos los bytes, también a los que no aparecen en las muestras
+    huffmanBuildStaticTable(symbolCounts, maxCodeLength, codeLengths);
+    huffmanWriteStaticTable(tableContent, tableId, codeLengths);
+
+    tableFile = openFile(tableFileName, "wb");
 
-    while(linkedListCopy != NULL){
+    if(fwrite(tableContent, 1, HUFFMAN_STATIC_TABLE_LENGTH, tableFile) != HUFFMAN_STATIC_TABLE_LENGTH || fclose(tableFile) != 0){
 
-        fprintf(file, "'%c' -> %d\n", linkedListCopy->stringCharacter.character, linkedListCopy->stringCharacter.frequency);
-        linkedListCopy = linkedListCopy->nextNode;
+        printf("ERROR: Ha ocurrido un error al escribir la tabla '%s'.\n", tableFileName);
+        exit(1);
 
     }
 
-    // Cerramos el fichero
-    fclose(file);
+    printf("TABLA: %d\n", tableId);
 
 }
 
-// freLinkedList
-void freeLinkedList(LinkedListNode_s *linkedList){
+// addFileName
+void addFileName(FileList_s *fileList, char *fileName){
 
-    // Avanzamos hasta el final de la lista
-    while(linkedList->nextNode != NULL)
-        linkedList = linkedList->nextNode;
-    
-    // Vamos liberando según retrocedemos en los elementos de la lista
-    while(linkedList->backNode != NULL){
+    // Ampliamos la lista duplicando su capacidad cuando se llena
+    if(fileList->fileNamesNumber == fileList->capacity){
 
-        linkedList = linkedList->backNode;
-        free(linkedList->nextNode);
+        fileList->capacity = (fileList->capacity > 0) ? fileList->capacity * 2 : 64;
+        fileList->fileNames = (char**)realloc(fileList->fileNames, fileList->capacity * sizeof(char*));
 
     }
 
-    // Liberamos el inicio de la lista
-    free(linkedList);
+    fileList->fileNames[fileList->fileNamesNumber] = strdup(fileName);
+    fileList->fileNamesNumber++;
 
 }
 
-// initTreeFromPriorityQueue
-TreeNode_s* initTreeFromPriorityQueue(LinkedListNode_s *queue){
+// readFileList
+int readFileList(FileList_s *fileList, char *listName){
 
     // Variables necesarias
-    TreeNode_s *treeRoot = NULL;
-    TreeNode_s *nodes = NULL;
-    LinkedListNode_s *queueCopy = NULL;
-    int nodesArrayLength = 0;
+    FILE *listFile = NULL;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    ssize_t lineLength = 0;
 
-    // Inicializamos la copia de la cola
-    queueCopy = queue;
+    // Abrimos la lista ("-" para la entrada estándar)
+    listFile = (strcmp(listName, "-") == 0) ? stdin : fopen(listName, "r");
 
-    // Transformamos los nodos de la lista de prioridad a nodos de árbol
-    while(queueCopy != NULL){
+    if(listFile == NULL){
 
-        // Reservamos memoria para el nuevo nodo
-        nodes = (TreeNode_s*)realloc(nodes, (nodesArrayLength + 1) * sizeof(TreeNode_s));
+        printf("ERROR: Ha ocurrido un error al intentar abrir la lista de ficheros '%s'.\n", listName);
+        return 1;
 
-        // Establecemos los datos del nuevo nodo e incrementamos el contador de nodos
-        nodes[nodesArrayLength].parentNode = NULL;
-        nodes[nodesArrayLength].leftChild = NULL;
-        nodes[nodesArrayLength].rightChild = NULL;
-        nodes[nodesArrayLength].stringCharacter.character = queueCopy->stringCharacter.character;
-        nodes[nodesArrayLength].stringCharacter.frequency = queueCopy->stringCharacter.frequency;
-        nodesArrayLength++;
+    }
 
-        // Avanzamos al siguiente nodo de la cola
-        queueCopy = queueCopy->nextNode;
+    // Añadimos un fichero por línea, ignorando las líneas vacías
+    while((lineLength = getline(&line, &lineCapacity, listFile)) > 0){
 
-    }
+        if(line[lineLength - 1] == '\n')
+            line[--lineLength] = '\0';
 
-    // Construimos el árbol
-    treeRoot = buildTree(&nodes, nodesArrayLength);
+        if(lineLength > 0)
+            addFileName(fileList, line);
+
+    }
 
     // Liberamos la memoria utilizada
-    free(nodes);
+    free(line);
 
-    // Devolvemos los datos
-    return treeRoot;
+    if(listFile != stdin)
+        fclose(listFile);
+
+    return 0;
 
 }
 
-// buildTree
-TreeNode_s* buildTree(TreeNode_s **nodes, int nodesLength){
+// walkDirectory
+int walkDirectory(FileList_s *fileList, char *directoryName){
 
     // Variables necesarias
-    TreeNode_s *rootNode = NULL;
-    TreeNode_s *leftNode = NULL;
-    TreeNode_s *rightNode = NULL;
-    int nodesLengthCopy = 0;
+    DIR *directory = NULL;
+    struct dirent *entry = NULL;
+    struct stat entryStat;
+    char *entryName = NULL;
+    size_t entryNameCapacity = 0;
+    size_t entryNameLength = 0;
+    int failedNamesNumber = 0;
+
+    if((directory = opendir(directoryName)) == NULL){
+
+        printf("ERROR: Ha ocurrido un error al intentar abrir el directorio '%s'.\n", directoryName);
+        return 1;
+
+    }
 
-    // Realizamos uan copia de la longitud del array
-    nodesLengthCopy = nodesLength;
+    while((entry = readdir(directory)) != NULL){
 
-    // Mientras queden varios nodos en el array
-    while(nodesLengthCopy > 1){
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
 
-        // Extraemos los dos nodos mínimos del array
-        leftNode = findMinNode(nodes, &nodesLengthCopy);
-        rightNode = findMinNode(nodes, &nodesLengthCopy);
+        // Componemos la ruta de la entrada reutilizando el mismo buffer
+        entryNameLength = strlen(directoryName) + strlen(entry->d_name) + 2;
 
-        // Creamos el nodo padre de ambos, lo inicializamos a caracter nulo y establecemos su frecuencia como la suma de ambos hijos
-        rootNode = (TreeNode_s*)malloc(sizeof(TreeNode_s));
-        rootNode->parentNode = NULL;
-        rootNode->stringCharacter.character = '\0';
-        rootNode->stringCharacter.frequency = leftNode->stringCharacter.frequency + rightNode->stringCharacter.frequency;
+        if(entryNameLength > entryNameCapacity){
 
-        // Establecemos las relaciones
-        rootNode->leftChild = leftNode;
-        leftNode->parentNode = rootNode;
+            entryNameCapacity = entryNameLength;
+            entryName = (char*)realloc(entryName, entryNameCapacity);
 
-        rootNode->rightChild = rightNode;
-        rightNode->parentNode = rootNode;
+        }
+
+        sprintf(entryName, "%s/%s", directoryName, entry->d_name);
 
-        // Insertamos el nuevo nodo al final del array
-        (*nodes)[nodesLengthCopy] = *rootNode;
-        nodesLengthCopy++;
+        // Recorremos los subdirectorios sin seguir enlaces y añadimos los ficheros regulares que no estén ya cifrados
+        if(lstat(entryName, &entryStat) != 0)
+            continue;
+
+        if(S_ISDIR(entryStat.st_mode))
+            failedNamesNumber += walkDirectory(fileList, entryName);
+        else if(S_ISREG(entryStat.st_mode) && (entryNameLength - 1 < strlen(ENCODED_EXTENSION) ||
+                strcmp(entryName + entryNameLength - 1 - strlen(ENCODED_EXTENSION), ENCODED_EXTENSION) != 0))
+            addFileName(fileList, entryName);
 
     }
 
-    return findMinNode(nodes, &nodesLengthCopy);
+    // Liberamos la memoria utilizada
+    free(entryName);
+    closedir(directory);
+
+    return failedNamesNumber;
+
+}
+
+// freeFileList
+void freeFileList(FileList_s *fileList){
+
+    for(int i = 0; i < fileList->fileNamesNumber; i++)
+        free(fileList->fileNames[i]);
+
+    free(fileList->fileNames);
+
+    fileList->fileNames = NULL;
+    fileList->fileNamesNumber = 0;
+    fileList->capacity = 0;
 
 }
 
-// findMinNode
-TreeNode_s* findMinNode(TreeNode_s **nodes, int *nodesLength){
+// compressBatch
+int compressBatch(FileList_s *fileList, char *fileListName, int threadsNumber, int blockSize, int maxCodeLength, int streamsNumber, int contextOrder, int *transforms, int transformsNumber, int lzLevel, int windowBits, int checkpointInterval, int staticTableId, byte *staticCodeLengths, HuffmanStats_s *stats){
 
     // Variables necesarias
-    TreeNode_s *minNode = NULL;
-    int minNodeIndex = 0;
+    FileList_s batchList = {NULL, 0, 0};
+    BatchPool_s batchPool;
+    BatchWorker_s *batchWorkers = NULL;
+    BatchTask_s batchTask = {NULL, NULL, 0};
+    struct stat fileStat;
+    int failedNamesNumber = 0;
+
+    // Reunimos todos los ficheros a cifrar: los indicados, los de la lista y los de los directorios
+    if(fileListName != NULL)
+        failedNamesNumber += readFileList(fileList, fileListName);
 
-    // Recorremos la lista de nodos buscando el nodo con menor frecuencia
-    for(int i = 0; i < *nodesLength; i++){
+    for(int i = 0; i < fileList->fileNamesNumber; i++){
 
-        if((*nodes)[i].stringCharacter.frequency < (*nodes)[minNodeIndex].stringCharacter.frequency)
-            minNodeIndex = i;
+        if(strcmp(fileList->fileNames[i], "-") == 0){
+
+            printf("ERROR: En el modo por lotes no se puede cifrar la entrada estándar.\n");
+            failedNamesNumber++;
+
+        }
+        else if(stat(fileList->fileNames[i], &fileStat) == 0 && S_ISDIR(fileStat.st_mode))
+            failedNamesNumber += walkDirectory(&batchList, fileList->fileNames[i]);
+        else
+            addFileName(&batchList, fileList->fileNames[i]);
 
     }
 
-    // Nos creamos el nodo mínimo y le inicializamos los valores
-    minNode = (TreeNode_s*)malloc(sizeof(TreeNode_s));
-    minNode->leftChild = (*nodes)[minNodeIndex].leftChild;
-    minNode->parentNode = (*nodes)[minNodeIndex].parentNode;
-    minNode->rightChild = (*nodes)[minNodeIndex].rightChild;
-    minNode->stringCharacter = (*nodes)[minNodeIndex].stringCharacter;
+    // Inicializamos el grupo de hilos, cada uno con su propia cola de tareas
+    batchPool.workersNumber = threadsNumber;
+    batchPool.blockSize = blockSize;
+    batchPool.maxCodeLength = maxCodeLength;
+    batchPool.pendingTasksNumber = 0;
+    batchPool.pushedTasksNumber = 0;
+    batchPool.failedFilesNumber = failedNamesNumber;
+    batchPool.encodedTotalLength = 0;
+    batchPool.decodedTotalLength = 0;
+    batchPool.stats = stats;
+    batchPool.taskDeques = (TaskDeque_s*)calloc(threadsNumber, sizeof(TaskDeque_s));
 
-    // Cambiamos el nodo mínimo por el último para "sacarlo" del array y decrementamos la longitud del array
-    (*nodes)[minNodeIndex] = (*nodes)[*nodesLength - 1];
-    *nodesLength -= 1;
+    pthread_mutex_init(&batchPool.mutex, NULL);
+    pthread_cond_init(&batchPool.taskAdded, NULL);
 
-    return minNode;
+    for(int i = 0; i < threadsNumber; i++)
+        pthread_mutex_init(&batchPool.taskDeques[i].mutex, NULL);
 
-}
+    // Repartimos los ficheros entre las colas, los hilos que vacíen la suya robarán de las demás
+    for(int i = 0; i < batchList.fileNamesNumber; i++){
 
-// printTree
-void printTree(FILE *file, TreeNode_s *tree){
+        batchTask.fileName = batchList.fileNames[i];
+        pushBatchTask(&batchPool, i % threadsNumber, batchTask);
 
-    if(tree->leftChild != NULL){
+    }
+
+    // Cada hilo reserva una única vez su contexto de cifrado y su buffer, y los reutiliza para todos sus ficheros
+    batchWorkers = (BatchWorker_s*)calloc(threadsNumber, sizeof(BatchWorker_s));
+
+    for(int i = 0; i < threadsNumber; i++){
+
+        batchWorkers[i].batchPool = &batchPool;
+        batchWorkers[i].workerNumber = i;
+        batchWorkers[i].encoder = huffmanCreateEncoder(blockSize, maxCodeLength, 1);
+        huffmanSetEncoderStreams(batchWorkers[i].encoder, streamsNumber);
+        huffmanSetEncoderContextOrder(batchWorkers[i].encoder, contextOrder);
+        huffmanSetEncoderTransforms(batchWorkers[i].encoder, transforms, transformsNumber);
+        huffmanSetEncoderLz77(batchWorkers[i].encoder, lzLevel, windowBits);
+        huffmanSetEncoderCheckpoints(batchWorkers[i].encoder, checkpointInterval);
 
-        fprintf(file, "L\n");
-        printTree(file, tree->leftChild);
+        if(staticTableId != 0)
+            huffmanSetEncoderStaticTable(batchWorkers[i].encoder, staticTableId, staticCodeLengths);
+
+        batchWorkers[i].encodedBlockCapacity = huffmanEncodeBlockBound(blockSize, maxCodeLength);
+        batchWorkers[i].encodedBlock = (byte*)malloc(batchWorkers[i].encodedBlockCapacity);
+
+        if(stats != NULL)
+            huffmanSetEncoderStats(batchWorkers[i].encoder, &batchWorkers[i].stats);
 
     }
-    else{
-        
-        fprintf(file, "%c\n", tree->stringCharacter.character);
-        return;
+
+    // El hilo principal hace de primer trabajador
+    for(int i = 1; i < threadsNumber; i++){
+
+        if(pthread_create(&batchWorkers[i].thread, NULL, batchWorker, &batchWorkers[i]) != 0){
+
+            printf("ERROR: No se ha podido crear el hilo %d.\n", i);
+            exit(1);
+
+        }
 
     }
 
-    if(tree->rightChild != NULL){
+    batchWorker(&batchWorkers[0]);
+
+    for(int i = 1; i < threadsNumber; i++)
+        pthread_join(batchWorkers[i].thread, NULL);
+
+    printf("FICHEROS: %d, LEN: %lld\n", batchList.fileNamesNumber + failedNamesNumber - batchPool.failedFilesNumber, batchPool.encodedTotalLength);
+
+    if(stats != NULL){
 
-        fprintf(file, "R\n");
-        printTree(file, tree->rightChild);
+        for(int i = 0; i < threadsNumber; i++)
+            huffmanAddStats(stats, &batchWorkers[i].stats);
+
+        stats->bytesIn = batchPool.decodedTotalLength;
+        stats->bytesOut = batchPool.encodedTotalLength;
 
     }
-    else{
 
-        fprintf(file, "%c\n", tree->stringCharacter.character);
-        return;
+    // Liberamos la memoria utilizada
+    for(int i = 0; i < threadsNumber; i++){
+
+        huffmanFreeEncoder(batchWorkers[i].encoder);
+        free(batchWorkers[i].encodedBlock);
+        free(batchWorkers[i].blockIndex.entries);
+        free(batchPool.taskDeques[i].tasks);
+        pthread_mutex_destroy(&batchPool.taskDeques[i].mutex);
 
     }
 
+    pthread_mutex_destroy(&batchPool.mutex);
+    pthread_cond_destroy(&batchPool.taskAdded);
+
+    free(batchWorkers);
+    free(batchPool.taskDeques);
+    freeFileList(&batchList);
+
+    return batchPool.failedFilesNumber;
+
 }
 
-// freeTree
-void freeTree(TreeNode_s *tree){
+// batchWorker
+void* batchWorker(void *arg){
 
-    // Caso base (El nodo es una hoja)
-    if(tree->leftChild == NULL && tree->rightChild == NULL)
-        free(tree);
-    // Si es una rama / raíz
-    else{
+    // Variables necesarias
+    BatchWorker_s *batchWorker = (BatchWorker_s*)arg;
+    BatchTask_s batchTask;
+
+    // Cada tarea es un fichero completo o uno de los bloques de un fichero grande
+    while(getBatchTask(batchWorker, &batchTask)){
+
+        if(batchTask.batchFile == NULL)
+            compressBatchFile(batchWorker, batchTask.fileName);
+        else
+            compressBatchBlock(batchWorker, batchTask.batchFile, batchTask.blockNumber);
 
-        // Si tiene hijo izquierdo lo liberamos
-        if(tree->leftChild != NULL)
-            freeTree(tree->leftChild);
-        
-        // Si tiene hijo derecho lo liberamos
-        if(tree->rightChild != NULL)
-            freeTree(tree->rightChild);
+        finishBatchTask(batchWorker->batchPool);
 
     }
 
+    return NULL;
+
 }
 
-// initHuffmanCodes
-HuffmanCode_s *initHuffmanCodes(){
+// getBatchTask
+int getBatchTask(BatchWorker_s *batchWorker, BatchTask_s *batchTask){
 
     // Variables necesarias
-    HuffmanCode_s *huffmanCodes = NULL;
+    BatchPool_s *batchPool = batchWorker->batchPool;
+    unsigned long long pushedTasksNumber = 0;
+    int finished = 0;
 
-    // Reservamos la memoria necesaria
-    huffmanCodes = (HuffmanCode_s*)malloc(HASH_TABLE_SIZE * sizeof(HuffmanCode_s));
+    while(1){
 
-    // Inicializamos los códigos de huffman
-    for(int i = 'a'; i <= 'z'; i++){
+        pthread_mutex_lock(&batchPool->mutex);
+        pushedTasksNumber = batchPool->pushedTasksNumber;
+        pthread_mutex_unlock(&batchPool->mutex);
 
-        huffmanCodes[getHash(i)].character = i;
-        huffmanCodes[getHash(i)].code = NULL;
-        huffmanCodes[getHash(i)].codeLength = 0;
+        // Primero sacamos la tarea más reciente de nuestra cola y si está vacía robamos la más antigua de otra
+        if(popBatchTask(&batchPool->taskDeques[batchWorker->workerNumber], batchTask))
+            return 1;
 
-    }
+        for(int i = 1; i < batchPool->workersNumber; i++){
 
-    for(int i = '0'; i <= '9'; i++){
+            if(stealBatchTask(&batchPool->taskDeques[(batchWorker->workerNumber + i) % batchPool->workersNumber], batchTask))
+                return 1;
 
-        huffmanCodes[getHash(i)].character = i;
-        huffmanCodes[getHash(i)].code = NULL;
-        huffmanCodes[getHash(i)].codeLength = 0;
+        }
 
-    }
+        // Si no hay nada que robar esperamos a que alguien encole una tarea nueva o a que terminen todas
+        pthread_mutex_lock(&batchPool->mutex);
 
-    huffmanCodes[getHash(' ')].character = ' ';
-    huffmanCodes[getHash(' ')].code = NULL;
-    huffmanCodes[getHash(' ')].codeLength = 0;
+        while(batchPool->pendingTasksNumber > 0 && batchPool->pushedTasksNumber == pushedTasksNumber)
+            pthread_cond_wait(&batchPool->taskAdded, &batchPool->mutex);
 
-    huffmanCodes[getHash(',')].character = ',';
-    huffmanCodes[getHash(',')].code = NULL;
-    huffmanCodes[getHash(',')].codeLength = 0;
-    
-    huffmanCodes[getHash('.')].character = '.';
-    huffmanCodes[getHash('.')].code = NULL;
-    huffmanCodes[getHash('.')].codeLength = 0;
+        finished = (batchPool->pendingTasksNumber == 0);
+        pthread_mutex_unlock(&batchPool->mutex);
 
-    // Devolvemos la tabla hash de códigos huffman inicializada
-    return huffmanCodes;
+        if(finished)
+            return 0;
+
+    }
 
 }
 
-// generateHuffmanTree
-void generateHuffmanCodes(HuffmanCode_s **huffmanCodes, TreeNode_s *huffmanTree, int *currentCode, int depth, int *maxDepth){
+// pushBatchTask
+void pushBatchTask(BatchPool_s *batchPool, int workerNumber, BatchTask_s batchTask){
 
     // Variables necesarias
-    int *currentCodeCopy = NULL;
+    TaskDeque_s *taskDeque = &batchPool->taskDeques[workerNumber];
 
-    // Caso base (Es un nodo hoja)
-    if(huffmanTree->leftChild == NULL && huffmanTree->rightChild == NULL){
+    // Contamos la tarea antes de que nadie pueda sacarla, así el grupo no termina mientras quede alguna
+    pthread_mutex_lock(&batchPool->mutex);
+    batchPool->pendingTasksNumber++;
+    pthread_mutex_unlock(&batchPool->mutex);
 
-        // Obtenemos el código Huffman del carácter 
-        (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].character = huffmanTree->stringCharacter.character;
-        (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].codeLength = depth;
-        (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code = (char*)malloc(sizeof(char));
-        (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code[0] = '0';
+    // Añadimos la tarea al final de la cola, compactándola o ampliándola si no cabe
+    pthread_mutex_lock(&taskDeque->mutex);
 
-        // Si la profundidad es mayor que 0 (No es el único nodo) transformamos el valor del array en cadena de caracteres
-        for(int i = 0; i < depth; i++){
+    if(taskDeque->bottom == taskDeque->capacity){
 
-            // Introducimos el caracter
-            (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code[i] = currentCode[i] + '0';
+        if(taskDeque->top > 0){
 
-            // Aumentamos el tamaño del array
-            (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code = (char*)realloc(
-                (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code, 
-                (i + 2) * sizeof(char)
-            );
+            memmove(taskDeque->tasks, taskDeque->tasks + taskDeque->top, (taskDeque->bottom - taskDeque->top) * sizeof(BatchTask_s));
+            taskDeque->bottom -= taskDeque->top;
+            taskDeque->top = 0;
 
         }
+        else{
 
-        // Introducimos el final de cadena
-        (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].code[depth] = '\0';
+            taskDeque->capacity = (taskDeque->capacity > 0) ? taskDeque->capacity * 2 : 64;
+            taskDeque->tasks = (BatchTask_s*)realloc(taskDeque->tasks, taskDeque->capacity * sizeof(BatchTask_s));
 
-        // Comprobamos si la longitud del código (depth) es mayor que la mayor actual
-        if(depth > *maxDepth)
-            *maxDepth = depth;
-
-        /* printf("CHAR: %c -> ARR: (", huffmanTree->stringCharacter.character);
-        for(int i = 0; i < depth; i++)
-            printf("%d, ", currentCode[i]);
-        printf(") NUM: %u\n", (*huffmanCodes)[getHash(huffmanTree->stringCharacter.character)].value); */
+        }
 
     }
-    // Si es un nodo rama / raíz
-    else{
 
-        // Nos copiamos el código actual
-        currentCodeCopy = (int*)realloc(currentCodeCopy, (depth + 1) * sizeof(int));
+    taskDeque->tasks[taskDeque->bottom++] = batchTask;
+    pthread_mutex_unlock(&taskDeque->mutex);
+
+    // Despertamos a los hilos que esperan por trabajo
+    pthread_mutex_lock(&batchPool->mutex);
+    batchPool->pushedTasksNumber++;
+    pthread_cond_broadcast(&batchPool->taskAdded);
+    pthread_mutex_unlock(&batchPool->mutex);
 
-        for(int i = 0; i < depth; i++)
-            currentCodeCopy[i] = currentCode[i];
+}
 
-        // Si tiene hijos a la izquierda
-        if(huffmanTree->leftChild != NULL){
+// finishBatchTask
+void finishBatchTask(BatchPool_s *batchPool){
 
-            // Le agregamos el código 0
-            currentCodeCopy[depth] = 0;
+    // Al terminar la última tarea despertamos a los hilos que esperan para que acaben
+    pthread_mutex_lock(&batchPool->mutex);
 
-            // Obtenemos los códigos de la rama izquierda
-            generateHuffmanCodes(huffmanCodes, huffmanTree->leftChild, currentCodeCopy, depth + 1, maxDepth);
+    if(--batchPool->pendingTasksNumber == 0)
+        pthread_cond_broadcast(&batchPool->taskAdded);
 
-        }
+    pthread_mutex_unlock(&batchPool->mutex);
 
-        // Si tiene hijos a la derecha
-        if(huffmanTree->rightChild != NULL){
+}
+
+// popBatchTask
+int popBatchTask(TaskDeque_s *taskDeque, BatchTask_s *batchTask){
 
-            // Le agregamos el código 1
-            currentCodeCopy[depth] = 1;
+    // Variables necesarias
+    int found = 0;
 
-            // Obtenemos los códigos de la rama derecha
-            generateHuffmanCodes(huffmanCodes, huffmanTree->rightChild, currentCodeCopy, depth + 1, maxDepth);
+    // El dueño de la cola saca las tareas por el final
+    pthread_mutex_lock(&taskDeque->mutex);
 
-        }
+    if(taskDeque->top < taskDeque->bottom){
 
-        // Liberamos la memoria utilizada
-        free(currentCodeCopy);
+        *batchTask = taskDeque->tasks[--taskDeque->bottom];
+        found = 1;
+
+        if(taskDeque->top == taskDeque->bottom)
+            taskDeque->top = taskDeque->bottom = 0;
 
     }
 
+    pthread_mutex_unlock(&taskDeque->mutex);
+
+    return found;
+
 }
 
-// printHuffmanCodes
-void printHuffmanCodes(char *fileName, LinkedListNode_s *charactersList, HuffmanCode_s *huffmanCodes){
+// stealBatchTask
+int stealBatchTask(TaskDeque_s *taskDeque, BatchTask_s *batchTask){
 
     // Variables necesarias
-    FILE *file = NULL;
-    LinkedListNode_s *charactersListCopy = NULL;
+    int found = 0;
 
-    // Abrimos el fichero
-    file = fopen(fileName, "w");
+    // Los demás hilos roban por el principio, donde están las tareas más antiguas
+    pthread_mutex_lock(&taskDeque->mutex);
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+    if(taskDeque->top < taskDeque->bottom){
 
-        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
-        exit(1);
+        *batchTask = taskDeque->tasks[taskDeque->top++];
+        found = 1;
+
+        if(taskDeque->top == taskDeque->bottom)
+            taskDeque->top = taskDeque->bottom = 0;
 
     }
 
-    // Realizamos una copia de la lista de caracteres
-    charactersListCopy = charactersList;
+    pthread_mutex_unlock(&taskDeque->mutex);
+
+    return found;
+
+}
+
+// compressBatchFile
+void compressBatchFile(BatchWorker_s *batchWorker, char *fileName){
 
-    // Recorremos la lista de caracteres mostrando los códigos huffman
-    while(charactersListCopy != NULL){
+    // Variables necesarias
+    BatchPool_s *batchPool = batchWorker->batchPool;
+    BatchFile_s *batchFile = NULL;
+    BatchTask_s batchTask;
+    InputFile_s inputFile;
+    char *encodedFileName = NULL;
+    FILE *encodedFile = NULL;
+    unsigned long long originalSize = HUFFMAN_UNKNOWN_ORIGINAL_SIZE;
+    size_t blockLength = 0;
+    long long encodedBlockLength = 0;
+    long long encodedFileLength = 0;
+    long long decodedFileLength = 0;
+
+    // Abrimos el fichero y su fichero cifrado '<fichero>.huff'
+    if(!tryOpenInputFile(&inputFile, fileName, batchPool->blockSize)){
+
+        failBatchFile(batchPool, "abrir el fichero", fileName);
+        return;
 
-        // Variables necesarias
-        char currentChar = '\0';
+    }
 
-        // Obtenemos el caracter
-        currentChar = charactersListCopy->stringCharacter.character;
+    encodedFileName = (char*)malloc(strlen(fileName) + strlen(ENCODED_EXTENSION) + 1);
+    sprintf(encodedFileName, "%s%s", fileName, ENCODED_EXTENSION);
+    encodedFile = fopen(encodedFileName, "wb");
 
-        /* printf("%c -> %d\n", currentChar, huffmanCodes[getHash(currentChar)].value); */
-        fprintf(file, "%c -> %s\n", currentChar, huffmanCodes[getHash(currentChar)].code);
+    if(encodedFile == NULL){
 
-        charactersListCopy = charactersListCopy->nextNode;
+        failBatchFile(batchPool, "crear el fichero cifrado de", fileName);
+        closeInputFile(inputFile);
+        free(encodedFileName);
+        return;
 
     }
 
-    fclose(file);
+    free(encodedFileName);
 
-}
+    if(inputFile.isMapped)
+        originalSize = inputFile.length;
 
-// encodeFileContent
-byte* encodeFileContent(FileContent_s fileContent, HuffmanCode_s *huffmanCodes, int maxCodeLength, int *bytesLength){
+    printContainerHeader(encodedFile, originalSize, 0);
+    encodedFileLength = HUFFMAN_CONTAINER_HEADER_LENGTH;
 
-    // Variables necesarias
-    byte *encodedFileContent = NULL;
-    byte *encodedFileContentCopy = NULL;
-    int charCounter = 0;
-    int bitCounter = 0;
-    byte auxByte = 0;
-
-    // Calculamos la cantidad de caracteres a codificar
-    for(int i = 0; i < fileContent.linesNumber; i++)
-        charCounter += fileContent.fileLines[i].lineLength;
-
-    // Reservamos memoria para la cadena codificada (El tamaño de los datos codificados y la cantidad de caracteres)
-    // Si el número de bits es múltiplo del tamaño de un byte pedimos el número de bits entre el tamaño de un byte
-    if(((charCounter * maxCodeLength) % (sizeof(byte) * BITS_IN_BYTE)) == 0)
-        encodedFileContent = (byte*)malloc((charCounter * maxCodeLength / BITS_IN_BYTE) + sizeof(int));
-    // Si no lo es, reservamos espacio para los bytes necesarios, más uno 
-    else
-        encodedFileContent = (byte*)malloc((charCounter * maxCodeLength / BITS_IN_BYTE) + 1 + sizeof(int));
-
-    // Realizamos una copia del puntero del contenido codificado
-    encodedFileContentCopy = encodedFileContent;
-
-    // Introducimos la cantidad de caracteres
-    memcpy(encodedFileContentCopy, &charCounter, sizeof(int));
-    encodedFileContentCopy += sizeof(int);
-
-    // Codificamos el contenido del fichero
-    for(int i = 0; i < fileContent.linesNumber; i++){
-
-        for(int j = 0; j < fileContent.fileLines[i].lineLength; j++){
-
-            for(int k = 0; k < huffmanCodes[getHash(fileContent.fileLines[i].lineContent[j])].codeLength; k++){
-
-                // Vamos introduciendo los bits del código huffman de la letra en el byte auxiliar (Si es 1 lo metemos y si es 0 no hace falta)
-                if(huffmanCodes[getHash(fileContent.fileLines[i].lineContent[j])].code[k] == '1')
-                    auxByte |= 0b1;
-                
-                bitCounter++;
-
-                // Si llegamos al tamaño de un byte
-                if(bitCounter >= BITS_IN_BYTE * sizeof(byte)){
-
-                    // Copiamos el byte en el puntero, lo avanzamos a la siguiente posición y reiniciamos el contador y el byte auxiliar
-                    memcpy(encodedFileContentCopy, &auxByte, sizeof(byte));
-                    encodedFileContentCopy += sizeof(byte);
-                    bitCounter = 0;
-                    auxByte = 0;
-                    *bytesLength += 1;
-
-                }
-                // Sino, avanzamos al siguiente bit
-                else
-                    auxByte <<= 1;
+    // Los ficheros proyectados de varios bloques se reparten por bloques, así un fichero enorme no deja al resto
+    // de hilos esperando. Encolamos los bloques del último al segundo para sacarlos nosotros en orden mientras
+    // los demás hilos roban primero otros ficheros y después los últimos bloques
+    if(inputFile.isMapped && inputFile.length > (size_t)batchPool->blockSize){
 
-            }
+        batchFile = (BatchFile_s*)calloc(1, sizeof(BatchFile_s));
+        batchFile->fileName = fileName;
+        batchFile->inputFile = inputFile;
+        batchFile->encodedFile = encodedFile;
+        batchFile->blocksNumber = (inputFile.length + batchPool->blockSize - 1) / batchPool->blockSize;
+        batchFile->pendingBlocks = (byte**)calloc(batchFile->blocksNumber, sizeof(byte*));
+        batchFile->pendingBlocksLength = (long long*)calloc(batchFile->blocksNumber, sizeof(long long));
+        batchFile->encodedFileLength = encodedFileLength;
+        pthread_mutex_init(&batchFile->mutex, NULL);
+
+        batchTask.fileName = fileName;
+        batchTask.batchFile = batchFile;
+
+        for(int i = batchFile->blocksNumber - 1; i > 0; i--){
+
+            batchTask.blockNumber = i;
+            pushBatchTask(batchPool, batchWorker->workerNumber, batchTask);
+
+        }
+
+        compressBatchBlock(batchWorker, batchFile, 0);
+        return;
 
-            /* for(int k = maxCodeLength - 1; k >= 0; k--){
+    }
 
-                // Vamos introduciendo los bits del código huffman de la letra en el byte auxiliar
-                auxByte |= ((huffmanCodes[getHash(fileContent.fileLines[i].lineContent[j])].value >> k) & 0b1);
-                bitCounter++;
+    // El resto de ficheros los ciframos directamente con el contexto y el buffer del hilo
+    batchWorker->blockIndex.entriesNumber = 0;
 
-                // Si llegamos al tamaño de un byte
-                if(bitCounter >= BITS_IN_BYTE * sizeof(byte)){
+    while((blockLength = ensureInputBytes(&inputFile, batchPool->blockSize)) > 0){
 
-                    // Copiamos el byte en el puntero, lo avanzamos a la siguiente posición y reiniciamos el contador y el byte auxiliar
-                    memcpy(encodedFileContentCopy, &auxByte, sizeof(byte));
-                    encodedFileContentCopy += sizeof(byte);
-                    bitCounter = 0;
-                    auxByte = 0;
+        encodedBlockLength = huffmanEncodeBlock(batchWorker->encoder, inputFile.content + inputFile.position, blockLength, batchWorker->encodedBlock, batchWorker->encodedBlockCapacity);
 
-                }
-                // Sino, avanzamos al siguiente bit
-                else
-                    auxByte <<= 1;
+        if(encodedBlockLength < 0){
 
-            } */
+            printf("ERROR: %s\n", huffmanErrorMessage(encodedBlockLength));
+            exit(1);
 
         }
 
+        addBlockIndexEntry(&batchWorker->blockIndex, encodedFileLength, decodedFileLength);
+        printEncodedBlock(encodedFile, batchWorker->encodedBlock, encodedBlockLength);
+        encodedFileLength += encodedBlockLength;
+        decodedFileLength += blockLength;
+        inputFile.position += blockLength;
+
     }
 
-    // Si nos quedan bits para llegar a un byte introducimos 0 hasta llegar al byte
-    if(bitCounter != 0){
+    addBlockIndexEntry(&batchWorker->blockIndex, encodedFileLength, decodedFileLength);
+    encodedFileLength += printBlockIndex(encodedFile, &batchWorker->blockIndex, encodedFileLength);
+
+    if(originalSize == HUFFMAN_UNKNOWN_ORIGINAL_SIZE && fseek(encodedFile, 0, SEEK_SET) == 0)
+        printContainerHeader(encodedFile, decodedFileLength, 0);
+
+    // Cerramos los ficheros
+    closeInputFile(inputFile);
 
-        auxByte <<= ((BITS_IN_BYTE * sizeof(byte)) - bitCounter);
+    if(fclose(encodedFile) != 0){
 
-        // Copiamos el byte en el puntero, lo avanzamos a la siguiente posición y reiniciamos el contador y el byte auxiliar
-        memcpy(encodedFileContentCopy, &auxByte, sizeof(byte));
-        encodedFileContentCopy += sizeof(byte);
-        bitCounter = 0;
-        auxByte = 0;
-        *bytesLength += 1;
+        failBatchFile(batchPool, "escribir el fichero cifrado de", fileName);
+        return;
 
     }
 
-    return encodedFileContent;
+    pthread_mutex_lock(&batchPool->mutex);
+    batchPool->encodedTotalLength += encodedFileLength;
+    batchPool->decodedTotalLength += decodedFileLength;
+    pthread_mutex_unlock(&batchPool->mutex);
 
 }
 
-void printEncodedFileContent(char *fileName, byte *encodeFileContent, int length){
+// compressBatchBlock
+void compressBatchBlock(BatchWorker_s *batchWorker, BatchFile_s *batchFile, int blockNumber){
 
     // Variables necesarias
-    FILE *file = NULL;
+    int blockSize = batchWorker->batchPool->blockSize;
+    size_t blockOffset = (size_t)blockNumber * blockSize;
+    size_t blockLength = 0;
+    long long encodedBlockLength = 0;
+    int finished = 0;
 
-    // Abrimos el fichero
-    file = fopen(fileName, "wb");
+    // Ciframos el bloque con el contexto del hilo
+    blockLength = batchFile->inputFile.length - blockOffset;
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+    if(blockLength > (size_t)blockSize)
+        blockLength = blockSize;
 
-        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
+    encodedBlockLength = huffmanEncodeBlock(batchWorker->encoder, batchFile->inputFile.content + blockOffset, blockLength, batchWorker->encodedBlock, batchWorker->encodedBlockCapacity);
+
+    if(encodedBlockLength < 0){
+
+        printf("ERROR: %s\n", huffmanErrorMessage(encodedBlockLength));
         exit(1);
 
     }
 
-    // Volcamos el contenido cifrado en el fichero
-    printf("LEN: %d\n", length);
-    fwrite(encodeFileContent, 1, length, file);
+    pthread_mutex_lock(&batchFile->mutex);
+
+    // Si es el siguiente bloque del fichero lo escribimos junto con los posteriores que ya estuvieran terminados,
+    // si no guardamos una copia hasta que le toque
+    if(blockNumber == batchFile->nextBlockToWrite){
+
+        writeBatchBlock(batchFile, batchWorker->encodedBlock, encodedBlockLength, blockSize);
+
+        while(batchFile->nextBlockToWrite < batchFile->blocksNumber && batchFile->pendingBlocks[batchFile->nextBlockToWrite] != NULL){
+
+            writeBatchBlock(batchFile, batchFile->pendingBlocks[batchFile->nextBlockToWrite], batchFile->pendingBlocksLength[batchFile->nextBlockToWrite], blockSize);
+            free(batchFile->pendingBlocks[batchFile->nextBlockToWrite - 1]);
+
+        }
+
+    }
+    else{
+
+        batchFile->pendingBlocks[blockNumber] = (byte*)malloc(encodedBlockLength);
+        batchFile->pendingBlocksLength[blockNumber] = encodedBlockLength;
+        memcpy(batchFile->pendingBlocks[blockNumber], batchWorker->encodedBlock, encodedBlockLength);
+
+    }
+
+    finished = (batchFile->nextBlockToWrite == batchFile->blocksNumber);
+    pthread_mutex_unlock(&batchFile->mutex);
+
+    // Quien escribe el último bloque termina el fichero
+    if(finished)
+        finishBatchFile(batchWorker, batchFile);
+
+}
+
+// writeBatchBlock
+void writeBatchBlock(BatchFile_s *batchFile, byte *encodedBlock, long long encodedBlockLength, int blockSize){
+
+    // Variables necesarias
+    long long blockLength = batchFile->inputFile.length - batchFile->decodedFileLength;
+
+    if(blockLength > blockSize)
+        blockLength = blockSize;
 
-    // Cerramos el fichero
-    fclose(file);
+    addBlockIndexEntry(&batchFile->blockIndex, batchFile->encodedFileLength, batchFile->decodedFileLength);
+    printEncodedBlock(batchFile->encodedFile, encodedBlock, encodedBlockLength);
+    batchFile->encodedFileLength += encodedBlockLength;
+    batchFile->decodedFileLength += blockLength;
+    batchFile->nextBlockToWrite++;
 
 }
 
-// initHashTable
-HashTable_s* initHashTable(){
+// finishBatchFile
+void finishBatchFile(BatchWorker_s *batchWorker, BatchFile_s *batchFile){
 
     // Variables necesarias
-    HashTable_s *hashTable = NULL;
+    BatchPool_s *batchPool = batchWorker->batchPool;
+    int failed = 0;
 
-    // Reservamos la memoria necesaria
-    hashTable = (HashTable_s*)malloc(HASH_TABLE_SIZE * sizeof(HashTable_s));
+    // Terminamos el fichero con el índice de bloques y lo cerramos
+    addBlockIndexEntry(&batchFile->blockIndex, batchFile->encodedFileLength, batchFile->decodedFileLength);
+    batchFile->encodedFileLength += printBlockIndex(batchFile->encodedFile, &batchFile->blockIndex, batchFile->encodedFileLength);
 
-    // Inicializamos la tabla hash
-    for(int i = 'a'; i <= 'z'; i++){
+    closeInputFile(batchFile->inputFile);
 
-        hashTable[getHash(i)].key = i;
-        hashTable[getHash(i)].value = 0;
+    if(fclose(batchFile->encodedFile) != 0){
+
+        failBatchFile(batchPool, "escribir el fichero cifrado de", batchFile->fileName);
+        failed = 1;
 
     }
 
-    for(int i = '0'; i <= '9'; i++){
+    if(!failed){
 
-        hashTable[getHash(i)].key = i;
-        hashTable[getHash(i)].value = 0;
+        pthread_mutex_lock(&batchPool->mutex);
+        batchPool->encodedTotalLength += batchFile->encodedFileLength;
+        batchPool->decodedTotalLength += batchFile->decodedFileLength;
+        pthread_mutex_unlock(&batchPool->mutex);
 
     }
 
-    hashTable[getHash(' ')].key = ' ';
-    hashTable[getHash(' ')].value = 0;
+    // Liberamos la memoria utilizada
+    pthread_mutex_destroy(&batchFile->mutex);
+    free(batchFile->pendingBlocks);
+    free(batchFile->pendingBlocksLength);
+    free(batchFile->blockIndex.entries);
+    free(batchFile);
 
-    hashTable[getHash(',')].key = ',';
-    hashTable[getHash(',')].value = 0;
+}
 
-    hashTable[getHash('.')].key = '.';
-    hashTable[getHash('.')].value = 0;;
+// failBatchFile
+void failBatchFile(BatchPool_s *batchPool, char *message, char *fileName){
 
-    // Devolvemos la información
-    return hashTable;
+    // Un fichero que falla no detiene el resto del lote, solo lo contamos para el código de salida
+    pthread_mutex_lock(&batchPool->mutex);
+    printf("ERROR: Ha ocurrido un error al intentar %s '%s'.\n", message, fileName);
+    batchPool->failedFilesNumber++;
+    pthread_mutex_unlock(&batchPool->mutex);
 
 }
 
-// getHash
-int getHash(char key){
+// printStats
+void printStats(HuffmanStats_s *stats, double wallTime, char *statsFileName){
 
     // Variables necesarias
-    int index = -1;
+    FILE *statsFile = stderr;
+    struct rusage usage;
+    const char *stagesNames[] = {"read", "transform", "histogram", "treeBuild", "match", "codeGeneration", "encode", "write"};
+    double stagesWallTimes[] = {stats->wallTimes.read, stats->wallTimes.transform, stats->wallTimes.histogram, stats->wallTimes.treeBuild,
+                                stats->wallTimes.match, stats->wallTimes.codeGeneration, stats->wallTimes.encode, stats->wallTimes.write};
+    double stagesCpuTimes[] = {stats->cpuTimes.read, stats->cpuTimes.transform, stats->cpuTimes.histogram, stats->cpuTimes.treeBuild,
+                               stats->cpuTimes.match, stats->cpuTimes.codeGeneration, stats->cpuTimes.encode, stats->cpuTimes.write};
+
+    if(statsFileName != NULL && (statsFile = fopen(statsFileName, "w")) == NULL){
+
+        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", statsFileName);
+        exit(1);
+
+    }
+
+    // El tiempo de CPU y el pico de memoria son los de todo el proceso, con todos sus hilos
+    getrusage(RUSAGE_SELF, &usage);
+
+    // Un único objeto JSON en una línea para que lo pueda recoger la monitorización
+    fprintf(statsFile, "{\"program\": \"cifrar\", \"wallSeconds\": %.6f, \"cpuSeconds\": %.6f, \"bytesIn\": %lld, \"bytesOut\": %lld, ",
+            wallTime, usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6, stats->bytesIn, stats->bytesOut);
+    fprintf(statsFile, "\"blocks\": %lld, \"symbols\": %lld, \"maxDistinctSymbols\": %d, \"maxCodeLength\": %d, \"averageBitsPerSymbol\": %.4f, ",
+            stats->blocksNumber, stats->symbolsNumber, stats->maxDistinctSymbols, stats->maxCodeLength,
+            (stats->symbolsNumber > 0) ? (double)stats->payloadBits / stats->symbolsNumber : 0.0);
+    fprintf(statsFile, "\"allocations\": %lld, \"peakMemoryKiB\": %ld, \"stages\": {", stats->allocationsNumber, usage.ru_maxrss);
+
+    for(int i = 0; i < (int)(sizeof(stagesNames) / sizeof(stagesNames[0])); i++)
+        fprintf(statsFile, "%s\"%s\": {\"wallSeconds\": %.6f, \"cpuSeconds\": %.6f}", (i > 0) ? ", " : "", stagesNames[i], stagesWallTimes[i], stagesCpuTimes[i]);
 
-    // Calculamos el hash en función del carácter
-    if(key >= 'a' && key <= 'z')
-        index = key - 'a';
-    else if(key >= 'A' && key <= 'Z')
-        index = key - 'A';
-    else if(key >= '0' && key <= '9')
-        index = key - 22;
-    else if(key == ' ')
-        index = 36;
-    else if(key == ',')
-        index = 37;
-    else if(key == '.')
-        index = 38;
+    fprintf(statsFile, "}}\n");
 
-    return index;
+    if(statsFile != stderr)
+        fclose(statsFile);
 
 }
 
@@ -894,90 +1932,73 @@ char *readLine(int *length){
 
 }
 
-// readFileContent
-FileContent_s readFileContent(char *fileName){
+// openFile
+FILE* openFile(char *fileName, char *mode){
 
     // Variables necesarias
-    FileContent_s fileContent;
     FILE *file = NULL;
 
     // Abrimos el fichero
-    file = fopen(fileName, "r");
+    file = fopen(fileName, mode);
 
     // Comprobamos que el fichero se haya abierto correctamente
     if(file == NULL){
 
-        printf("ERROR: El fichero no se ha podido abrir correctamente.\n");
+        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
         exit(1);
 
     }
 
-    // Inicializamos el contenido del fichero
-    fileContent.fileLines = NULL;
-    fileContent.linesNumber = 0;
-
-    // Mientras no nos encontremos con el final del fichero leemos línea a línea y la vamos introduciendo
-    while(!feof(file)){
+    return file;
 
-        fileContent.linesNumber += 1;
-        fileContent.fileLines = (FileLine_s*)realloc(fileContent.fileLines, fileContent.linesNumber * sizeof(FileLine_s));
-        fileContent.fileLines[fileContent.linesNumber - 1] = readFileLine(file);
+}
 
-    }
+// parseTransforms
+int parseTransforms(char *transformsList, int *transforms){
 
-    // Cerramos el fichero
-    fclose(file);
+    // Variables necesarias
+    const char *transformsNames[] = {"rle", "bwt", "mtf"};
+    int transformsNamesNumber = sizeof(transformsNames) / sizeof(transformsNames[0]);
+    int transformsNumber = 0;
+    int transform = 0;
+    char *transformName = transformsList;
+    char *separator = NULL;
 
-    // Devolvemos la información
-    return fileContent;
+    // Cada nombre de la lista es una transformación, se aplican en el orden en que aparecen
+    while(transformName != NULL){
 
-}
+        if((separator = strchr(transformName, ',')) != NULL)
+            *separator = '\0';
 
-// readFileLine
-FileLine_s readFileLine(FILE *file){
+        // Una lista vacía o con comas de más no indica ninguna transformación, así que no la damos por buena
+        if(transformName[0] == '\0'){
 
-    // Variables necesarias
-    FileLine_s fileLine;
-    char auxCharacter = '\0';
+            printf("ERROR: La lista de transformaciones tiene un nombre vacío, deben ser 'rle', 'bwt' o 'mtf' separados por comas.\n");
+            exit(1);
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+        }
 
-        printf("ERROR: No se ha podido abrir correctamente el fichero.\n");
-        exit(1);
+        for(transform = 0; transform < transformsNamesNumber && strcmp(transformName, transformsNames[transform]) != 0; transform++);
 
-    }
+        if(transform == transformsNamesNumber){
 
-    // Inicializamos las variables
-    fileLine.lineLength = 0;
-    fileLine.lineContent = (char*)malloc(sizeof(char));
+            printf("ERROR: La transformación '%s' no existe, deben ser 'rle', 'bwt' o 'mtf'.\n", transformName);
+            exit(1);
 
-    // Leemos la línea del fichero hasta que nos encontremos con un intro, o un final de fichero
-    while ((auxCharacter = getc(file)) != '\n' && !feof(file))
-    {
-        
-        fileLine.lineContent[fileLine.lineLength] = auxCharacter;
-        fileLine.lineLength += 1;
-        fileLine.lineContent = (char*)realloc(fileLine.lineContent, (fileLine.lineLength + 1) * sizeof(char));
+        }
 
-    }
+        if(transformsNumber == HUFFMAN_MAX_TRANSFORMS_NUMBER){
 
-    // Introducimos el final de línea
-    fileLine.lineContent[fileLine.lineLength] = '\0';
+            printf("ERROR: Se pueden encadenar como mucho %d transformaciones.\n", HUFFMAN_MAX_TRANSFORMS_NUMBER);
+            exit(1);
 
-    // Devollvemos la información
-    return fileLine;
+        }
 
-}
+        transforms[transformsNumber++] = HUFFMAN_TRANSFORM_RLE + transform;
+        transformName = (separator != NULL) ? separator + 1 : NULL;
 
-// freeFileContent
-void freeFileContent(FileContent_s fileContent){
+    }
 
-    // Liberamos cada cadena de texto de cada línea
-    for(int i = 0; i < fileContent.linesNumber; i++)
-        free(fileContent.fileLines[i].lineContent);
-    
-    // Liberamos el puntero de líneas
-    free(fileContent.fileLines);
+    return transformsNumber;
 
-}
+}
\ No newline at end of file
@@ -12,367 +12,850 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+// Inclusión de bibliotecas propias
+#include "huffman.h"
+#include "entradaSalida.h"
 
 // Definición de constantes
-#define TREE_FILE "tree.txt"
+#define byte unsigned char
 #define ENCODED_FILE "compressed.bin"
 
-#define byte char
-#define BITS_IN_BYTE 8
+#define INPUT_BUFFER_SIZE (64 * 1024)
+#define IO_BUFFER_SIZE HUFFMAN_DEFAULT_BLOCK_SIZE
+#define MAX_THREADS_NUMBER 256
+#define MAX_STATIC_TABLES_NUMBER (HUFFMAN_MAX_TABLE_ID - HUFFMAN_FIRST_USER_TABLE_ID + 1)
 
 /* Declaraciones Globales */
 // Estructuras
-typedef struct FileLine_s{
+// Tablas estáticas entrenadas que se cargan en cada contexto de descifrado (Las de la biblioteca se cargan solas)
+typedef struct StaticTableList_s{
 
-    int lineLength;
-    char *lineContent;
+    int tableIds[MAX_STATIC_TABLES_NUMBER];
+    byte codeLengths[MAX_STATIC_TABLES_NUMBER][HUFFMAN_SYMBOLS_NUMBER];
+    int tablesNumber;
 
-}FileLine_s;
+}StaticTableList_s;
 
-typedef struct FileContent_s{
+typedef struct ParallelDecoder_s{
 
-    int linesNumber;
-    FileLine_s *fileLines;
+    byte *encodedContent;
+    unsigned long long originalSize;
+    long long indexOffset;
+    HuffmanBlockIndexEntry_s *blockIndex;
+    int blocksNumber;
+    byte *decodedContent;
+    int nextBlock;
+    StaticTableList_s *staticTables;
+    HuffmanStats_s *stats;
+    pthread_mutex_t mutex;
 
-}FileContent_s;
+}ParallelDecoder_s;
 
-typedef struct BinFileContent_s{
+// Prototipado de Funciones
+// Funciones de descifrado
+unsigned long long readContainerHeader(InputFile_s *encodedFile, int *options);
+void decodeSequentially(InputFile_s *encodedFile, FILE *outputFile, unsigned long long originalSize, StaticTableList_s *staticTables, HuffmanStats_s *stats);
+void decodeAdaptively(InputFile_s *encodedFile, FILE *outputFile, HuffmanStats_s *stats);
+void decodeRange(InputFile_s *encodedFile, FILE *outputFile, unsigned long long offset, size_t length, StaticTableList_s *staticTables, HuffmanStats_s *stats);
 
-    int length;
-    byte *fileContent;
+// Funciones de descifrado en paralelo
+int readBlockIndex(ParallelDecoder_s *parallelDecoder, InputFile_s *encodedFile);
+void decodeInParallel(ParallelDecoder_s *parallelDecoder, int threadsNumber, char *outputFileName);
+void* parallelDecoderWorker(void *arg);
+void decodeIndexedBlock(ParallelDecoder_s *parallelDecoder, int blockNumber, HuffmanDecoder_s *decoder);
 
-}BinFileContent_s;
+// Funciones de las tablas estáticas
+void loadStaticTable(StaticTableList_s *staticTables, char *tableFileName);
+void addStaticTables(HuffmanDecoder_s *decoder, StaticTableList_s *staticTables);
 
-typedef struct StringCharacter_s{
+// Funciones de estadísticas
+void printStats(HuffmanStats_s *stats, double wallTime, char *statsFileName);
 
-    char character;
-    int frequency;
+/* Función Principal Main */
+int main(int argc, char **argv){
 
-}StringCharacter_s;
+    // Variables necesarias
+    char *fileName = NULL;
+    char *outputFileName = NULL;
+    int threadsNumber = 1;
+    InputFile_s encodedFile;
+    FILE *outputFile = NULL;
+    struct stat outputStat;
+    unsigned long long originalSize = 0;
+    int options = 0;
+    ParallelDecoder_s parallelDecoder;
+    StaticTableList_s staticTables;
+    int statsEnabled = 0;
+    char *statsFileName = NULL;
+    HuffmanStats_s programStats;
+    HuffmanStats_s *stats = NULL;
+    HuffmanStageClock_s programClock;
+    HuffmanStageClock_s stageClock;
+    double wallTime = 0;
+    int isRange = 0;
+    unsigned long long rangeOffset = 0;
+    unsigned long long rangeLength = 0;
+    char *rangeEnd = NULL;
+
+    huffmanMeasureStage(&programClock, NULL, NULL);
+    staticTables.tablesNumber = 0;
+
+    // Leemos las opciones de la línea de comandos
+    for(int i = 1; i < argc; i++){
+
+        // Número de hilos (0 para usar todos los procesadores disponibles)
+        if(strcmp(argv[i], "-T") == 0 && i + 1 < argc){
+
+            threadsNumber = atoi(argv[++i]);
+
+            if(threadsNumber == 0)
+                threadsNumber = sysconf(_SC_NPROCESSORS_ONLN);
+
+            if(threadsNumber < 1 || threadsNumber > MAX_THREADS_NUMBER){
+
+                fprintf(stderr, "ERROR: El número de hilos debe estar entre 1 y %d (0 para usar todos los procesadores).\n", MAX_THREADS_NUMBER);
+                exit(1);
 
-typedef struct TreeNode_s{
+            }
 
-    StringCharacter_s stringCharacter;
-    struct TreeNode_s *parentNode;
-    struct TreeNode_s *leftChild;
-    struct TreeNode_s *rightChild;
+        }
+        // Tramo del fichero original a descifrar: "inicio:longitud" en bytes
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
 
-}TreeNode_s;
+            rangeOffset = strtoull(argv[++i], &rangeEnd, 10);
 
-// Prototipado de Funciones
-// Funciones de Árboles
-TreeNode_s* buildTreeFromFile(char *fileName);
-void freeTree(TreeNode_s *tree);
+            if(argv[i][0] < '0' || argv[i][0] > '9' || *rangeEnd != ':' || rangeEnd[1] < '0' || rangeEnd[1] > '9'){
 
-// Funciones Huffman
-char *decodeFileContent(BinFileContent_s fileContent, TreeNode_s *huffmanTree);
+                fprintf(stderr, "ERROR: El tramo debe indicarse como inicio:longitud.\n");
+                exit(1);
 
-// Funciones auxiliares
-FileContent_s readFileContent(char *fileName);
-FileLine_s readFileLine(FILE *file);
-void freeFileContent(FileContent_s fileContent);
+            }
 
-// Funciones de ficheros binarios
-BinFileContent_s readBinFile(char *fileName);
+            rangeLength = strtoull(rangeEnd + 1, &rangeEnd, 10);
 
-/* Función Principal Main */
-int main(int argc, char **argv){
+            if(*rangeEnd != '\0'){
 
-    // Variables necesarias
-    TreeNode_s *huffmanTree = NULL;
-    BinFileContent_s encodedFileContent;
-    char *decodedContent = NULL;
+                fprintf(stderr, "ERROR: El tramo debe indicarse como inicio:longitud.\n");
+                exit(1);
+
+            }
+
+            isRange = 1;
+
+        }
+        // Fichero de salida (Por defecto la salida estándar)
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            outputFileName = argv[++i];
+        // Tabla estática entrenada con "cifrar -E" (Se puede repetir para cargar varias)
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            loadStaticTable(&staticTables, argv[++i]);
+        // Estadísticas en JSON por la salida de errores o, con "--stats=fichero", en un fichero
+        else if(strcmp(argv[i], "--stats") == 0)
+            statsEnabled = 1;
+        else if(strncmp(argv[i], "--stats=", strlen("--stats=")) == 0){
+
+            statsEnabled = 1;
+            statsFileName = argv[i] + strlen("--stats=");
+
+        }
+        // Nombre del fichero cifrado ("-" para la entrada estándar)
+        else if((argv[i][0] != '-' || argv[i][1] == '\0') && fileName == NULL)
+            fileName = argv[i];
+        else{
+
+            fprintf(stderr, "Uso: %s [-T hilos] [-t tabla] [-r inicio:longitud] [-o salida] [--stats[=fichero]] [fichero]\n", argv[0]);
+            exit(1);
+
+        }
+
+    }
+
+    if(fileName == NULL)
+        fileName = ENCODED_FILE;
+
+    if(statsEnabled){
+
+        memset(&programStats, 0, sizeof(programStats));
+        stats = &programStats;
+
+    }
+
+    parallelDecoder.staticTables = &staticTables;
+    parallelDecoder.stats = stats;
+
+    // Abrimos el fichero cifrado (Proyectado en memoria si es posible)
+    measureProgramStage(stats, &stageClock, STAGE_START);
+    encodedFile = openInputFile(fileName, INPUT_BUFFER_SIZE);
+    measureProgramStage(stats, &stageClock, STAGE_READ);
 
-    // Reconstruímos el árbol de Huffman
-    huffmanTree = buildTreeFromFile(TREE_FILE);
+    // Comprobamos la cabecera del contenedor y leemos el tamaño original
+    originalSize = readContainerHeader(&encodedFile, &options);
+    parallelDecoder.originalSize = originalSize;
 
-    // Obtenemos el contenido del fichero cifrado
-    encodedFileContent = readBinFile(ENCODED_FILE);
+    if(isRange && (options & HUFFMAN_OPTION_ADAPTIVE)){
 
-    // Desciframos el contenido del fichero
-    decodedContent = decodeFileContent(encodedFileContent, huffmanTree);
+        fprintf(stderr, "ERROR: Los flujos adaptativos no tienen índice, no se puede usar -r.\n");
+        exit(1);
+
+    }
+
+    // El tramo nunca pasa del final del fichero original, así no reservamos más de lo que se puede descifrar
+    if(isRange && originalSize != HUFFMAN_UNKNOWN_ORIGINAL_SIZE)
+        rangeLength = (rangeOffset >= originalSize) ? 0 : (rangeLength < originalSize - rangeOffset) ? rangeLength : originalSize - rangeOffset;
+
+    // Con varios hilos, la entrada proyectada y un fichero regular de salida desciframos los bloques a la vez
+    // usando el índice del final del fichero, cada uno directamente en su posición de la salida
+    if(!isRange && !(options & HUFFMAN_OPTION_ADAPTIVE) && threadsNumber > 1 && encodedFile.isMapped && outputFileName != NULL &&
+       (stat(outputFileName, &outputStat) != 0 || S_ISREG(outputStat.st_mode)) && readBlockIndex(&parallelDecoder, &encodedFile)){
+
+        decodeInParallel(&parallelDecoder, threadsNumber, outputFileName);
+
+        if(stats != NULL){
+
+            stats->bytesIn = encodedFile.length;
+            stats->bytesOut = parallelDecoder.blockIndex[parallelDecoder.blocksNumber].decodedOffset;
 
-    printf("Contenido: %s\n", decodedContent);
+        }
+
+        free(parallelDecoder.blockIndex);
+
+    }
+    // Si no recorremos los bloques uno detrás de otro
+    else{
+
+        if(outputFileName == NULL)
+            outputFile = stdout;
+        else if((outputFile = fopen(outputFileName, "wb")) == NULL){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", outputFileName);
+            exit(1);
+
+        }
+
+        // Un tramo se descifra saltando con el índice a sus bloques
+        // Los flujos adaptativos no tienen índice y se descifran trozo a trozo según llegan
+        if(isRange)
+            decodeRange(&encodedFile, outputFile, rangeOffset, rangeLength, &staticTables, stats);
+        else if(options & HUFFMAN_OPTION_ADAPTIVE)
+            decodeAdaptively(&encodedFile, outputFile, stats);
+        else
+            decodeSequentially(&encodedFile, outputFile, originalSize, &staticTables, stats);
+
+        // Al cerrar la salida (O vaciarla si es la salida estándar) se escribe lo que quedaba en el buffer, así que también puede fallar
+        measureProgramStage(stats, &stageClock, STAGE_START);
+
+        if((outputFile != stdout) ? fclose(outputFile) != 0 : fflush(outputFile) != 0){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero de salida.\n");
+            exit(1);
+
+        }
+
+        measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+    }
 
     // Liberamos la memoria utilizada
-    freeTree(huffmanTree);
+    closeInputFile(encodedFile);
 
-    free(encodedFileContent.fileContent);
-    free(decodedContent);
+    if(stats != NULL){
+
+        huffmanMeasureStage(&programClock, &wallTime, NULL);
+        printStats(stats, wallTime, statsFileName);
+
+    }
 
     return 0;
 
 }
 
 /* Codificación de Funciones */
-// buildTreeFromFile
-TreeNode_s* buildTreeFromFile(char *fileName){
+// readContainerHeader
+unsigned long long readContainerHeader(InputFile_s *encodedFile, int *options){
 
     // Variables necesarias
-    FileContent_s treeFileContent;
-    char currentChar = '\0';
-    TreeNode_s *treeRoot = NULL;
-    TreeNode_s *treeRootCopy = NULL;
+    unsigned long long originalSize = 0;
+    long long headerLength = 0;
 
-    // Leemos el contenido del fichero
-    treeFileContent = readFileContent(fileName);
+    // Comprobamos la cabecera del contenedor y obtenemos el tamaño original
+    headerLength = huffmanReadContainerHeader(encodedFile->content + encodedFile->position, ensureInputBytes(encodedFile, HUFFMAN_CONTAINER_HEADER_LENGTH), &originalSize, options);
 
-    // Inicializamos el árbol
-    treeRoot = (TreeNode_s*)malloc(sizeof(TreeNode_s));
-    treeRoot->parentNode = NULL;
-    treeRoot->leftChild = NULL;
-    treeRoot->rightChild = NULL;
-    treeRootCopy = treeRoot;
+    if(headerLength < 0){
 
-    // Reconstruímos el árbol de Huffman
-    for(int i = 0; i < treeFileContent.linesNumber; i++){
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(headerLength));
+        exit(1);
 
-        currentChar = treeFileContent.fileLines[i].lineContent[0];
+    }
 
-        if(currentChar == 'L'){
+    encodedFile->position += headerLength;
 
-            // Nos creamos un nuevo hijo izquierdo y nos movemos a él
-            treeRootCopy->leftChild = (TreeNode_s*)malloc(sizeof(TreeNode_s));
-            treeRootCopy->leftChild->parentNode = treeRootCopy;
-            treeRootCopy = treeRootCopy->leftChild;
+    return originalSize;
 
-        }
-        else if(currentChar == 'R'){
+}
+
+// decodeSequentially
+void decodeSequentially(InputFile_s *encodedFile, FILE *outputFile, unsigned long long originalSize, StaticTableList_s *staticTables, HuffmanStats_s *stats){
+
+    // Variables necesarias
+    HuffmanDecoder_s *decoder = NULL;
+    size_t availableBytes = 0;
+    long long frameLength = 0;
+    long long decodedBlockLength = 0;
+    int charactersNumber = 0;
+    unsigned long long decodedLength = 0;
+    byte *decodedContent = NULL;
+    size_t decodedContentCapacity = 0;
+    OutputWriter_s *outputWriter = NULL;
+    HuffmanStageClock_s stageClock;
+
+    // Un único contexto para todos los bloques, así el árbol y la tabla de descifrado se reutilizan
+    decoder = huffmanCreateDecoder();
+    huffmanSetDecoderStats(decoder, stats);
+    addStaticTables(decoder, staticTables);
+
+    // Un hilo lee los bloques siguientes y otro escribe los anteriores mientras desciframos el actual
+    startInputReader(encodedFile, IO_BUFFER_SIZE);
+    outputWriter = startOutputWriter(outputFile, 0);
+
+    if(stats != NULL)
+        stats->bytesIn = HUFFMAN_CONTAINER_HEADER_LENGTH;
+
+    // Recorremos los bloques del fichero hasta la marca del índice o el final del fichero
+    while(1){
+
+        measureProgramStage(stats, &stageClock, STAGE_START);
+
+        if((availableBytes = ensureInputBytes(encodedFile, 1)) == 0)
+            break;
+
+        // Vamos leyendo el bloque hasta tenerlo entero (Mientras falten bytes la biblioteca nos indica cuántos necesita)
+        while((frameLength = huffmanGetBlockFrameLength(encodedFile->content + encodedFile->position, availableBytes, &charactersNumber)) > (long long)availableBytes){
+
+            availableBytes = ensureInputBytes(encodedFile, frameLength);
+
+            if(availableBytes < (size_t)frameLength){
+
+                fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(HUFFMAN_ERROR_INCOMPLETE));
+                exit(1);
 
-            // Vamos escalando el árbol buscando el primer nodo que no tiene hijo derecho
-            while(treeRootCopy->rightChild != NULL){
-                /* printf("SUBE\n"); */
-                treeRootCopy = treeRootCopy->parentNode;
             }
 
-            // Nos creamos el nuevo hijo derecho y nos movemos a él
-            treeRootCopy->rightChild = (TreeNode_s*)malloc(sizeof(TreeNode_s));
-            treeRootCopy->rightChild->parentNode = treeRootCopy;
-            treeRootCopy = treeRootCopy->rightChild;
+        }
+
+        if(frameLength < 0){
+
+            fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(frameLength));
+            exit(1);
 
         }
-        else if(currentChar){
 
-            // Introducimos el carácter y nos vamos al nodo anterior
-            treeRootCopy->stringCharacter.character = currentChar;
-            treeRootCopy = treeRootCopy->parentNode;
+        // La marca del índice indica que ya no quedan bloques
+        if(frameLength == 0)
+            break;
+
+        prefetchInputBytes(encodedFile, encodedFile->position + frameLength, frameLength);
+        measureProgramStage(stats, &stageClock, STAGE_READ);
+
+        // Reutilizamos los buffers descifrados entre bloques, solo crecen si un bloque es mayor que los anteriores
+        if((size_t)charactersNumber > decodedContentCapacity){
+
+            decodedContentCapacity = charactersNumber;
+            decodedContent = (byte*)realloc(decodedContent, decodedContentCapacity);
 
         }
 
+        // Desciframos el bloque directamente desde la entrada y se lo entregamos tal cual al hilo escritor (Puede contener cualquier byte)
+        decodedBlockLength = huffmanDecodeBlock(decoder, encodedFile->content + encodedFile->position, frameLength, decodedContent, decodedContentCapacity);
+
+        if(decodedBlockLength < 0){
+
+            fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(decodedBlockLength));
+            exit(1);
+
+        }
+
+        measureProgramStage(stats, &stageClock, STAGE_START);
+        queueOutputBuffer(outputWriter, &decodedContent, &decodedContentCapacity, decodedBlockLength);
+        measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+        encodedFile->position += frameLength;
+        decodedLength += decodedBlockLength;
+
+        if(stats != NULL)
+            stats->bytesIn += frameLength;
+
     }
 
-    return treeRoot;
+    // Esperamos a que se escriban todos los bloques
+    measureProgramStage(stats, &stageClock, STAGE_START);
 
-}
+    if(!finishOutputWriter(outputWriter)){
 
-// freeTree
-void freeTree(TreeNode_s *tree){
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero descifrado.\n");
+        exit(1);
 
-    // Caso base (El nodo es una hoja)
-    if(tree->leftChild == NULL && tree->rightChild == NULL)
-        free(tree);
-    // Si es una rama / raíz
-    else{
+    }
 
-        // Si tiene hijo izquierdo lo liberamos
-        if(tree->leftChild != NULL)
-            freeTree(tree->leftChild);
-        
-        // Si tiene hijo derecho lo liberamos
-        if(tree->rightChild != NULL)
-            freeTree(tree->rightChild);
+    measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+    // Si la cabecera indicaba el tamaño original comprobamos que coincide con lo descifrado
+    if(originalSize != HUFFMAN_UNKNOWN_ORIGINAL_SIZE && decodedLength != originalSize){
+
+        fprintf(stderr, "ERROR: El tamaño descifrado no coincide con el del fichero original.\n");
+        exit(1);
 
     }
 
+    if(stats != NULL)
+        stats->bytesOut = decodedLength;
+
+    // Liberamos la memoria utilizada
+    huffmanFreeDecoder(decoder);
+    free(decodedContent);
+
 }
 
-// decodeFileContent
-char* decodeFileContent(BinFileContent_s fileContent, TreeNode_s *huffmanTree){
+// decodeAdaptively
+void decodeAdaptively(InputFile_s *encodedFile, FILE *outputFile, HuffmanStats_s *stats){
 
     // Variables necesarias
-    char *decodedContent = NULL;
-    int decodedContentLength = 0;
-    byte *auxPointer = NULL;
-    byte auxByte = '\0';
+    HuffmanAdaptiveModel_s *model = NULL;
+    size_t availableBytes = 0;
+    long long chunkLength = 0;
+    long long decodedChunkLength = 0;
     int charactersNumber = 0;
-    TreeNode_s *huffmanTreeCopy = NULL;
+    unsigned long long decodedLength = 0;
+    byte *decodedContent = NULL;
+    int decodedContentCapacity = 0;
+    HuffmanStageClock_s stageClock;
+
+    // Tras la cabecera va la longitud máxima de código con la que se creó el modelo del cifrado
+    if(ensureInputBytes(encodedFile, 1) < 1){
+
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(HUFFMAN_ERROR_INCOMPLETE));
+        exit(1);
+
+    }
 
-    // Inicializamos el contenido descifrado
-    decodedContent = (char*)malloc(sizeof(char));
+    if((model = huffmanCreateAdaptiveModel(encodedFile->content[encodedFile->position])) == NULL){
 
-    // Inicializamos el puntero auxiliar al contenido del fichero
-    auxPointer = fileContent.fileContent;
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(HUFFMAN_ERROR_CORRUPT));
+        exit(1);
 
-    // Obtenemos el número de caracteres de la cadena
-    memcpy(&charactersNumber, auxPointer, sizeof(int));
-    auxPointer += sizeof(int);
+    }
 
-    // Inicializamos la copia del árbol de Huffman
-    huffmanTreeCopy = huffmanTree;
+    huffmanSetAdaptiveStats(model, stats);
+    encodedFile->position++;
 
-    // Recorremos el resto de bytes descifrando la información
-    for(int i = 0; i < fileContent.length - sizeof(int); i++){
+    if(stats != NULL)
+        stats->bytesIn = HUFFMAN_CONTAINER_HEADER_LENGTH + 1;
 
-        // Copiamos el byte en el byte auxiliar
-        memcpy(&auxByte, auxPointer, sizeof(byte));
-        auxPointer += sizeof(byte);
+    // Desciframos cada trozo en cuanto está completo y lo volcamos enseguida, hasta el trozo vacío del final
+    do{
 
-        // Recorremos los bits del byte de izquierda a derecha (más significativo a menos significativo)
-        for(int j = BITS_IN_BYTE - 1; j >= 0; j--){
+        measureProgramStage(stats, &stageClock, STAGE_START);
+        availableBytes = ensureInputBytes(encodedFile, 1);
 
-            // Si estamos en un nodo hoja leemos su valor y lo volcamos a la cadena descifrada
-            if(huffmanTreeCopy->leftChild == NULL && huffmanTreeCopy->rightChild == NULL){
+        while((chunkLength = huffmanGetAdaptiveChunkLength(encodedFile->content + encodedFile->position, availableBytes, &charactersNumber)) > (long long)availableBytes){
 
+            availableBytes = ensureInputBytes(encodedFile, chunkLength);
 
-                decodedContent[decodedContentLength] = huffmanTreeCopy->stringCharacter.character;
-                decodedContentLength++;
-                decodedContent = (char*)realloc(decodedContent, (decodedContentLength + 1) * sizeof(char));
+            if(availableBytes < (size_t)chunkLength){
 
-                // Volvemos al inicio del árbol para empezar a leer otro carácter
-                huffmanTreeCopy = huffmanTree;
+                fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(HUFFMAN_ERROR_INCOMPLETE));
+                exit(1);
 
             }
 
-            // Si nos tenemos que ir a la izquierda avanzamos el puntero a su hijo izquierdo
-            if(((auxByte >> j) & 0b1) == 0)
-                huffmanTreeCopy = huffmanTreeCopy->leftChild;
-            // Si nos tenemos que ir a la derecha avanzamos el puntero a su hijo derecho
-            else
-                huffmanTreeCopy = huffmanTreeCopy->rightChild;
+        }
+
+        if(chunkLength < 0){
+
+            fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(chunkLength));
+            exit(1);
 
         }
 
-    }
+        measureProgramStage(stats, &stageClock, STAGE_READ);
+
+        if(charactersNumber > decodedContentCapacity){
 
-    // Insertamos el carácter de fin de cadena a la cadena con el contenido descifrado
-    decodedContent[decodedContentLength] = '\0';
+            decodedContentCapacity = charactersNumber;
+            decodedContent = (byte*)realloc(decodedContent, decodedContentCapacity);
+
+        }
+
+        decodedChunkLength = huffmanDecodeAdaptiveChunk(model, encodedFile->content + encodedFile->position, chunkLength, decodedContent, decodedContentCapacity);
+
+        if(decodedChunkLength < 0){
+
+            fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(decodedChunkLength));
+            exit(1);
+
+        }
 
-    return decodedContent;
+        // El trozo vacío del final no tiene nada que volcar (Y si es el único el buffer ni siquiera existe)
+        measureProgramStage(stats, &stageClock, STAGE_START);
+
+        if(decodedChunkLength > 0 && (fwrite(decodedContent, 1, decodedChunkLength, outputFile) != (size_t)decodedChunkLength || fflush(outputFile) != 0)){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero de salida.\n");
+            exit(1);
+
+        }
+
+        measureProgramStage(stats, &stageClock, STAGE_WRITE);
+
+        encodedFile->position += chunkLength;
+        decodedLength += decodedChunkLength;
+
+        if(stats != NULL)
+            stats->bytesIn += chunkLength;
+
+    }while(charactersNumber > 0);
+
+    if(stats != NULL)
+        stats->bytesOut = decodedLength;
+
+    // Liberamos la memoria utilizada
+    huffmanFreeAdaptiveModel(model);
+    free(decodedContent);
 
 }
 
-// readFileContent
-FileContent_s readFileContent(char *fileName){
+// decodeRange
+void decodeRange(InputFile_s *encodedFile, FILE *outputFile, unsigned long long offset, size_t length, StaticTableList_s *staticTables, HuffmanStats_s *stats){
 
     // Variables necesarias
-    FileContent_s fileContent;
-    FILE *file = NULL;
+    HuffmanDecoder_s *decoder = NULL;
+    byte *decodedContent = NULL;
+    long long decodedLength = 0;
+    HuffmanStageClock_s stageClock;
 
-    // Abrimos el fichero
-    file = fopen(fileName, "r");
+    // La biblioteca lee el índice y los bloques del tramo directamente de la proyección, así que del fichero
+    // solo se cargan las páginas que se tocan
+    if(!encodedFile->isMapped){
+
+        fprintf(stderr, "ERROR: Para descifrar un tramo el fichero cifrado debe ser un fichero normal.\n");
+        exit(1);
+
+    }
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+    decoder = huffmanCreateDecoder();
+    huffmanSetDecoderStats(decoder, stats);
+    addStaticTables(decoder, staticTables);
 
-        printf("ERROR: El fichero no se ha podido abrir correctamente.\n");
+    if(length > 0 && (decodedContent = (byte*)malloc(length)) == NULL){
+
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(HUFFMAN_ERROR_CAPACITY));
+        exit(1);
+
+    }
+
+    decodedLength = huffmanDecodeRange(decoder, encodedFile->content, encodedFile->length, offset, length, decodedContent);
+
+    if(decodedLength < 0){
+
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(decodedLength));
         exit(1);
 
     }
 
-    // Inicializamos el contenido del fichero
-    fileContent.fileLines = NULL;
-    fileContent.linesNumber = 0;
+    // Un rango recortado a 0 bytes no tiene buffer que volcar
+    measureProgramStage(stats, &stageClock, STAGE_START);
 
-    // Mientras no nos encontremos con el final del fichero leemos línea a línea y la vamos introduciendo
-    while(!feof(file)){
+    if(decodedLength > 0 && fwrite(decodedContent, 1, decodedLength, outputFile) != (size_t)decodedLength){
 
-        fileContent.linesNumber += 1;
-        fileContent.fileLines = (FileLine_s*)realloc(fileContent.fileLines, fileContent.linesNumber * sizeof(FileLine_s));
-        fileContent.fileLines[fileContent.linesNumber - 1] = readFileLine(file);
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero de salida.\n");
+        exit(1);
 
     }
 
-    // Cerramos el fichero
-    fclose(file);
+    measureProgramStage(stats, &stageClock, STAGE_WRITE);
 
-    // Devolvemos la información
-    return fileContent;
+    if(stats != NULL)
+        stats->bytesOut = decodedLength;
+
+    // Liberamos la memoria utilizada
+    huffmanFreeDecoder(decoder);
+    free(decodedContent);
 
 }
 
-// readFileLine
-FileLine_s readFileLine(FILE *file){
+// readBlockIndex
+int readBlockIndex(ParallelDecoder_s *parallelDecoder, InputFile_s *encodedFile){
 
     // Variables necesarias
-    FileLine_s fileLine;
-    char auxCharacter = '\0';
+    long long blocksNumber = 0;
+
+    // Si el fichero no termina en un índice válido lo desciframos de forma secuencial
+    blocksNumber = huffmanReadBlockIndex(encodedFile->content, encodedFile->length, NULL, 0);
 
-    // Comprobamos que el fichero se haya abierto correctamente
-    if(file == NULL){
+    if(blocksNumber < 0)
+        return 0;
 
-        printf("ERROR: No se ha podido abrir correctamente el fichero.\n");
+    // Leemos las entradas (Una más que bloques, la última marca el final de ambos ficheros)
+    parallelDecoder->blocksNumber = blocksNumber;
+    parallelDecoder->blockIndex = (HuffmanBlockIndexEntry_s*)malloc((blocksNumber + 1) * sizeof(HuffmanBlockIndexEntry_s));
+    huffmanReadBlockIndex(encodedFile->content, encodedFile->length, parallelDecoder->blockIndex, blocksNumber + 1);
+
+    // El final del índice debe coincidir con el tamaño original si la cabecera lo indica
+    if(parallelDecoder->originalSize != HUFFMAN_UNKNOWN_ORIGINAL_SIZE && (unsigned long long)parallelDecoder->blockIndex[blocksNumber].decodedOffset != parallelDecoder->originalSize){
+
+        fprintf(stderr, "ERROR: El tamaño descifrado no coincide con el del fichero original.\n");
         exit(1);
 
     }
 
-    // Inicializamos las variables
-    fileLine.lineLength = 0;
-    fileLine.lineContent = (char*)malloc(sizeof(char));
+    parallelDecoder->encodedContent = encodedFile->content;
+
+    return 1;
+
+}
+
+// decodeInParallel
+void decodeInParallel(ParallelDecoder_s *parallelDecoder, int threadsNumber, char *outputFileName){
+
+    // Variables necesarias
+    int outputDescriptor = 0;
+    long long decodedLength = 0;
+    pthread_t *threads = NULL;
+
+    // Creamos el fichero de salida con su tamaño final y lo proyectamos para escribir cada bloque en su sitio
+    decodedLength = parallelDecoder->blockIndex[parallelDecoder->blocksNumber].decodedOffset;
+    outputDescriptor = open(outputFileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if(outputDescriptor < 0 || ftruncate(outputDescriptor, decodedLength) != 0){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", outputFileName);
+        exit(1);
+
+    }
+
+    parallelDecoder->decodedContent = NULL;
+
+    if(decodedLength > 0){
+
+        parallelDecoder->decodedContent = (byte*)mmap(NULL, decodedLength, PROT_READ | PROT_WRITE, MAP_SHARED, outputDescriptor, 0);
+
+        if(parallelDecoder->decodedContent == MAP_FAILED){
+
+            fprintf(stderr, "ERROR: No se ha podido proyectar el fichero '%s'.\n", outputFileName);
+            exit(1);
+
+        }
+
+    }
+
+    // Lanzamos los hilos, cada uno va tomando el siguiente bloque pendiente
+    parallelDecoder->nextBlock = 0;
+    pthread_mutex_init(&parallelDecoder->mutex, NULL);
+
+    threads = (pthread_t*)malloc(threadsNumber * sizeof(pthread_t));
+
+    for(int i = 0; i < threadsNumber; i++){
+
+        if(pthread_create(&threads[i], NULL, parallelDecoderWorker, parallelDecoder) != 0){
+
+            fprintf(stderr, "ERROR: No se ha podido crear el hilo %d.\n", i);
+            exit(1);
+
+        }
+
+    }
+
+    for(int i = 0; i < threadsNumber; i++)
+        pthread_join(threads[i], NULL);
 
-    // Leemos la línea del fichero hasta que nos encontremos con un intro, o un final de fichero
-    while ((auxCharacter = getc(file)) != '\n' && !feof(file))
-    {
-        
-        fileLine.lineContent[fileLine.lineLength] = auxCharacter;
-        fileLine.lineLength += 1;
-        fileLine.lineContent = (char*)realloc(fileLine.lineContent, (fileLine.lineLength + 1) * sizeof(char));
+    // Liberamos los recursos utilizados
+    pthread_mutex_destroy(&parallelDecoder->mutex);
+
+    if(decodedLength > 0)
+        munmap(parallelDecoder->decodedContent, decodedLength);
+
+    close(outputDescriptor);
+    free(threads);
+
+}
+
+// parallelDecoderWorker
+void* parallelDecoderWorker(void *arg){
+
+    // Variables necesarias
+    ParallelDecoder_s *parallelDecoder = (ParallelDecoder_s*)arg;
+    int blockNumber = 0;
+    HuffmanDecoder_s *decoder = NULL;
+    HuffmanStats_s workerStats;
+
+    // Cada hilo tiene su propio contexto de descifrado y sus propias estadísticas
+    decoder = huffmanCreateDecoder();
+    memset(&workerStats, 0, sizeof(workerStats));
+
+    if(parallelDecoder->stats != NULL)
+        huffmanSetDecoderStats(decoder, &workerStats);
+
+    addStaticTables(decoder, parallelDecoder->staticTables);
+
+    while(1){
+
+        // Tomamos el siguiente bloque pendiente
+        pthread_mutex_lock(&parallelDecoder->mutex);
+        blockNumber = parallelDecoder->nextBlock++;
+        pthread_mutex_unlock(&parallelDecoder->mutex);
+
+        if(blockNumber >= parallelDecoder->blocksNumber)
+            break;
+
+        decodeIndexedBlock(parallelDecoder, blockNumber, decoder);
 
     }
 
-    // Introducimos el final de línea
-    fileLine.lineContent[fileLine.lineLength] = '\0';
+    // Juntamos las estadísticas del hilo con las del programa
+    if(parallelDecoder->stats != NULL){
 
-    // Devollvemos la información
-    return fileLine;
+        pthread_mutex_lock(&parallelDecoder->mutex);
+        huffmanAddStats(parallelDecoder->stats, &workerStats);
+        pthread_mutex_unlock(&parallelDecoder->mutex);
+
+    }
+
+    // Liberamos la memoria utilizada
+    huffmanFreeDecoder(decoder);
+
+    return NULL;
 
 }
 
-// freeFileContent
-void freeFileContent(FileContent_s fileContent){
+// decodeIndexedBlock
+void decodeIndexedBlock(ParallelDecoder_s *parallelDecoder, int blockNumber, HuffmanDecoder_s *decoder){
+
+    // Variables necesarias
+    byte *block = NULL;
+    long long blockLength = 0;
+    long long decodedBlockLength = 0;
+
+    // El bloque ocupa desde su posición hasta la del siguiente y se descifra directamente en su posición del fichero de salida
+    // La cantidad de caracteres que indica el índice es la capacidad, así un bloque que no coincida con el índice no se sale de su hueco
+    block = parallelDecoder->encodedContent + parallelDecoder->blockIndex[blockNumber].compressedOffset;
+    blockLength = parallelDecoder->blockIndex[blockNumber + 1].compressedOffset - parallelDecoder->blockIndex[blockNumber].compressedOffset;
 
-    // Liberamos cada cadena de texto de cada línea
-    for(int i = 0; i < fileContent.linesNumber; i++)
-        free(fileContent.fileLines[i].lineContent);
-    
-    // Liberamos el puntero de líneas
-    free(fileContent.fileLines);
+    decodedBlockLength = huffmanDecodeBlock(decoder, block, blockLength, parallelDecoder->decodedContent + parallelDecoder->blockIndex[blockNumber].decodedOffset,
+                                            parallelDecoder->blockIndex[blockNumber + 1].decodedOffset - parallelDecoder->blockIndex[blockNumber].decodedOffset);
+
+    if(decodedBlockLength < 0){
+
+        fprintf(stderr, "ERROR: %s\n", huffmanErrorMessage(decodedBlockLength));
+        exit(1);
+
+    }
+
+    if(decodedBlockLength != parallelDecoder->blockIndex[blockNumber + 1].decodedOffset - parallelDecoder->blockIndex[blockNumber].decodedOffset){
+
+        fprintf(stderr, "ERROR: El índice de bloques no coincide con el contenido.\n");
+        exit(1);
+
+    }
 
 }
 
-// readBinFile
-BinFileContent_s readBinFile(char *fileName){
+// loadStaticTable
+void loadStaticTable(StaticTableList_s *staticTables, char *tableFileName){
 
     // Variables necesarias
-    FILE *file = NULL;
-    BinFileContent_s fileContent;
-    byte auxByte = '\0';
+    FILE *tableFile = NULL;
+    byte tableContent[HUFFMAN_STATIC_TABLE_LENGTH];
+    size_t tableLength = 0;
+    long long status = 0;
+
+    if(staticTables->tablesNumber == MAX_STATIC_TABLES_NUMBER){
+
+        fprintf(stderr, "ERROR: No se pueden cargar más de %d tablas.\n", MAX_STATIC_TABLES_NUMBER);
+        exit(1);
 
-    // Abrimos el fichero y comprobamos que no haya errores
-    file = fopen(fileName, "rb");
+    }
 
-    if(file == NULL){
+    if((tableFile = fopen(tableFileName, "rb")) == NULL){
 
-        printf("ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'", fileName);
+        fprintf(stderr, "ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", tableFileName);
         exit(1);
 
     }
 
-    // Inicializamos el contenido del fichero
-    fileContent.length = 0;
-    fileContent.fileContent = NULL;
+    tableLength = fread(tableContent, 1, HUFFMAN_STATIC_TABLE_LENGTH, tableFile);
+    fclose(tableFile);
+
+    status = huffmanReadStaticTable(tableContent, tableLength, &staticTables->tableIds[staticTables->tablesNumber], staticTables->codeLengths[staticTables->tablesNumber]);
 
-    // Leemos el contenido del fichero
-    while((auxByte = fgetc(file)) != EOF){
+    if(status < 0){
 
-        fileContent.fileContent = (byte*)realloc(fileContent.fileContent, (fileContent.length + 1) * sizeof(byte));
-        fileContent.fileContent[fileContent.length] = auxByte;
-        fileContent.length++;
+        fprintf(stderr, "ERROR: La tabla '%s' no es válida: %s\n", tableFileName, huffmanErrorMessage(status));
+        exit(1);
 
     }
 
-    // Cerramos el fichero
-    fclose(file);
+    staticTables->tablesNumber++;
+
+}
+
+// addStaticTables
+void addStaticTables(HuffmanDecoder_s *decoder, StaticTableList_s *staticTables){
+
+    // Las tablas de descifrado se construyen aquí una única vez por contexto, antes del primer bloque
+    for(int i = 0; i < staticTables->tablesNumber; i++){
+
+        if(huffmanAddDecoderStaticTable(decoder, staticTables->tableIds[i], staticTables->codeLengths[i]) < 0){
+
+            fprintf(stderr, "ERROR: La tabla %d no es válida.\n", staticTables->tableIds[i]);
+            exit(1);
+
+        }
 
-    return fileContent;
+    }
 
 }
+
+// printStats
+void printStats(HuffmanStats_s *stats, double wallTime, char *statsFileName){
+
+    // Variables necesarias
+    FILE *statsFile = stderr;
+    struct rusage usage;
+    const char *stagesNames[] = {"read", "decodeTable", "decode", "transform", "write"};
+    double stagesWallTimes[] = {stats->wallTimes.read, stats->wallTimes.decodeTable, stats->wallTimes.decode, stats->wallTimes.transform, stats->wallTimes.write};
+    double stagesCpuTimes[] = {stats->cpuTimes.read, stats->cpuTimes.decodeTable, stats->cpuTimes.decode, stats->cpuTimes.transform, stats->cpuTimes.write};
+
+    if(statsFileName != NULL && (statsFile = fopen(statsFileName, "w")) == NULL){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", statsFileName);
+        exit(1);
+
+    }
+
+    // El tiempo de CPU y el pico de memoria son los de todo el proceso, con todos sus hilos
+    getrusage(RUSAGE_SELF, &usage);
+
+    // Un único objeto JSON en una línea para que lo pueda recoger la monitorización
+    // Los bits por símbolo se calculan con el contenido cifrado, que incluye el relleno del último byte de cada bloque
+    fprintf(statsFile, "{\"program\": \"descifrar\", \"wallSeconds\": %.6f, \"cpuSeconds\": %.6f, \"bytesIn\": %lld, \"bytesOut\": %lld, ",
+            wallTime, usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6, stats->bytesIn, stats->bytesOut);
+    fprintf(statsFile, "\"blocks\": %lld, \"symbols\": %lld, \"maxDistinctSymbols\": %d, \"maxCodeLength\": %d, \"averageBitsPerSymbol\": %.4f, ",
+            stats->blocksNumber, stats->symbolsNumber, stats->maxDistinctSymbols, stats->maxCodeLength,
+            (stats->symbolsNumber > 0) ? (double)stats->payloadBits / stats->symbolsNumber : 0.0);
+    fprintf(statsFile, "\"allocations\": %lld, \"peakMemoryKiB\": %ld, \"stages\": {", stats->allocationsNumber, usage.ru_maxrss);
+
+    for(int i = 0; i < (int)(sizeof(stagesNames) / sizeof(stagesNames[0])); i++)
+        fprintf(statsFile, "%s\"%s\": {\"wallSeconds\": %.6f, \"cpuSeconds\": %.6f}", (i > 0) ? ", " : "", stagesNames[i], stagesWallTimes[i], stagesCpuTimes[i]);
+
+    fprintf(statsFile, "}}\n");
+
+    if(statsFile != stderr)
+        fclose(statsFile);
+
+}
\ No newline at end of file
@@ -0,0 +1,618 @@
+/*
+    Título: Entrada y salida
+    Nombre: Héctor Paredes Benavides
+    Descripción: Entrada proyectada o con lectura adelantada y salida con un hilo escritor, comunes a cifrar y descifrar
+    Fecha: 16/10/2026
+*/
+
+/* Instrucciones de Preprocesado */
+// Inclusión de bibliotecas externas
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <errno.h>
+
+// Inclusión de bibliotecas propias
+#include "entradaSalida.h"
+
+// Definición de constantes
+#define byte unsigned char
+
+/* Codificación de Funciones */
+// measureProgramStage
+void measureProgramStage(HuffmanStats_s *stats, HuffmanStageClock_s *stageClock, int stage){
+
+    // Sin estadísticas no leemos el reloj
+    if(stats == NULL)
+        return;
+
+    // Sumamos lo transcurrido a la etapa indicada o, con STAGE_START, solo empezamos a contar
+    if(stage == STAGE_READ)
+        huffmanMeasureStage(stageClock, &stats->wallTimes.read, &stats->cpuTimes.read);
+    else if(stage == STAGE_WRITE)
+        huffmanMeasureStage(stageClock, &stats->wallTimes.write, &stats->cpuTimes.write);
+    else
+        huffmanMeasureStage(stageClock, NULL, NULL);
+
+}
+
+// openInputFile
+InputFile_s openInputFile(char *fileName, size_t bufferSize){
+
+    // Variables necesarias
+    InputFile_s inputFile;
+
+    if(!tryOpenInputFile(&inputFile, fileName, bufferSize)){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al intentar abrir el fichero '%s'.\n", fileName);
+        exit(1);
+
+    }
+
+    return inputFile;
+
+}
+
+// tryOpenInputFile
+int tryOpenInputFile(InputFile_s *inputFile, char *fileName, size_t bufferSize){
+
+    // Variables necesarias
+    struct stat fileStat;
+
+    // Inicializamos la entrada
+    inputFile->file = NULL;
+    inputFile->reader = NULL;
+    inputFile->content = NULL;
+    inputFile->length = 0;
+    inputFile->position = 0;
+    inputFile->capacity = 0;
+    inputFile->isMapped = 0;
+
+    // El nombre "-" indica la entrada estándar, el resto de ficheros se abren en modo binario
+    if(strcmp(fileName, "-") == 0)
+        inputFile->file = stdin;
+    else
+        inputFile->file = fopen(fileName, "rb");
+
+    // Comprobamos que el fichero se haya abierto correctamente
+    if(inputFile->file == NULL)
+        return 0;
+
+    // Si es un fichero regular lo proyectamos en memoria y trabajamos directamente sobre sus páginas
+    if(fstat(fileno(inputFile->file), &fileStat) == 0 && S_ISREG(fileStat.st_mode)){
+
+        if(fileStat.st_size == 0)
+            inputFile->isMapped = 1;
+        else{
+
+            inputFile->content = (byte*)mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileno(inputFile->file), 0);
+
+            if(inputFile->content != MAP_FAILED){
+
+                madvise(inputFile->content, fileStat.st_size, MADV_SEQUENTIAL);
+                inputFile->length = fileStat.st_size;
+                inputFile->isMapped = 1;
+
+            }
+            else
+                inputFile->content = NULL;
+
+        }
+
+    }
+
+    // Si no se ha podido proyectar (Tuberías, dispositivos...) leemos con un buffer reutilizable
+    if(!inputFile->isMapped){
+
+        inputFile->capacity = bufferSize;
+        inputFile->content = (byte*)malloc(inputFile->capacity);
+
+    }
+
+    return 1;
+
+}
+
+// ensureInputBytes
+size_t ensureInputBytes(InputFile_s *inputFile, size_t bytesNumber){
+
+    // Variables necesarias
+    ssize_t readBytes = 0;
+
+    // Si faltan bytes en el buffer movemos los pendientes al principio y lo rellenamos desde el fichero
+    if(!inputFile->isMapped && inputFile->length - inputFile->position < bytesNumber){
+
+        memmove(inputFile->content, inputFile->content + inputFile->position, inputFile->length - inputFile->position);
+        inputFile->length -= inputFile->position;
+        inputFile->position = 0;
+
+        // Si los bytes pedidos no caben ampliamos el buffer
+        if(bytesNumber > inputFile->capacity){
+
+            inputFile->capacity = bytesNumber;
+            inputFile->content = (byte*)realloc(inputFile->content, inputFile->capacity);
+
+        }
+
+        // Si hay hilo lector tomamos lo que ya ha leído, si no leemos del descriptor para no esperar a llenar el buffer
+        // si ya tenemos los bytes pedidos (Importa con tuberías)
+        while(inputFile->length < bytesNumber){
+
+            if(inputFile->reader != NULL)
+                readBytes = readInputReader(inputFile->reader, inputFile->content + inputFile->length, inputFile->capacity - inputFile->length);
+            else{
+
+                readBytes = read(fileno(inputFile->file), inputFile->content + inputFile->length, inputFile->capacity - inputFile->length);
+
+                // Si una señal interrumpe la lectura la repetimos, cualquier otro error no puede pasar por el final del fichero
+                if(readBytes < 0 && errno == EINTR)
+                    continue;
+
+                if(readBytes < 0){
+
+                    fprintf(stderr, "ERROR: Ha ocurrido un error al leer el fichero de entrada.\n");
+                    exit(1);
+
+                }
+
+            }
+
+            if(readBytes == 0)
+                break;
+
+            inputFile->length += readBytes;
+
+        }
+
+    }
+
+    // Devolvemos cuántos de los bytes pedidos hay disponibles a partir de la posición actual
+    if(inputFile->length - inputFile->position < bytesNumber)
+        return inputFile->length - inputFile->position;
+
+    return bytesNumber;
+
+}
+
+// prefetchInputBytes
+void prefetchInputBytes(InputFile_s *inputFile, size_t offset, size_t bytesNumber){
+
+    // Variables necesarias
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t start = 0;
+    size_t end = 0;
+
+    // Sin proyección no hace falta, el hilo lector ya va por delante
+    if(!inputFile->isMapped || offset >= inputFile->length)
+        return;
+
+    // Pedimos al núcleo que vaya trayendo las páginas del siguiente bloque mientras procesamos el actual
+    start = offset & ~(pageSize - 1);
+    end = (bytesNumber < inputFile->length - offset) ? offset + bytesNumber : inputFile->length;
+    madvise(inputFile->content + start, end - start, MADV_WILLNEED);
+
+}
+
+// closeInputFile
+void closeInputFile(InputFile_s inputFile){
+
+    // Paramos el hilo lector si lo hay
+    if(inputFile.reader != NULL)
+        stopInputReader(inputFile.reader);
+
+    // Deshacemos la proyección o liberamos el buffer de lectura
+    if(inputFile.isMapped){
+
+        if(inputFile.content != NULL)
+            munmap(inputFile.content, inputFile.length);
+
+    }
+    else
+        free(inputFile.content);
+
+    if(inputFile.file != stdin)
+        fclose(inputFile.file);
+
+}
+
+// startInputReader
+void startInputReader(InputFile_s *inputFile, size_t bufferSize){
+
+    // Variables necesarias
+    InputReader_s *inputReader = NULL;
+
+    // La entrada proyectada la trae el núcleo, el hilo lector solo hace falta con tuberías y dispositivos
+    if(inputFile->isMapped)
+        return;
+
+    // Inicializamos el anillo de buffers, todos libres
+    inputReader = (InputReader_s*)calloc(1, sizeof(InputReader_s));
+    inputReader->file = inputFile->file;
+    inputReader->bufferSize = bufferSize;
+
+    for(int i = 0; i < IO_BUFFERS_NUMBER; i++)
+        inputReader->buffers[i] = (byte*)malloc(bufferSize);
+
+    pthread_mutex_init(&inputReader->mutex, NULL);
+    pthread_cond_init(&inputReader->bufferRead, NULL);
+    pthread_cond_init(&inputReader->bufferConsumed, NULL);
+
+    if(pthread_create(&inputReader->thread, NULL, inputReaderThread, inputReader) != 0){
+
+        fprintf(stderr, "ERROR: No se ha podido crear el hilo lector.\n");
+        exit(1);
+
+    }
+
+    inputFile->reader = inputReader;
+
+}
+
+// inputReaderThread
+void* inputReaderThread(void *arg){
+
+    // Variables necesarias
+    InputReader_s *inputReader = (InputReader_s*)arg;
+    size_t readBytes = 0;
+    ssize_t result = 0;
+    int buffer = 0;
+
+    while(1){
+
+        // Esperamos a que haya un buffer libre o a que nos pidan terminar
+        pthread_mutex_lock(&inputReader->mutex);
+
+        while(inputReader->readyBuffersNumber == IO_BUFFERS_NUMBER && !inputReader->finish)
+            pthread_cond_wait(&inputReader->bufferConsumed, &inputReader->mutex);
+
+        if(inputReader->finish){
+
+            pthread_mutex_unlock(&inputReader->mutex);
+            break;
+
+        }
+
+        buffer = (inputReader->firstBuffer + inputReader->readyBuffersNumber) % IO_BUFFERS_NUMBER;
+        pthread_mutex_unlock(&inputReader->mutex);
+
+        // Llenamos el buffer fuera del cerrojo, el programa no lo toca hasta que lo marcamos como listo
+        // Cada buffer va lleno salvo el último, así el programa puede quedarse con él como un bloque entero
+        readBytes = 0;
+        result = 0;
+
+        while(readBytes < inputReader->bufferSize){
+
+            result = read(fileno(inputReader->file), inputReader->buffers[buffer] + readBytes, inputReader->bufferSize - readBytes);
+
+            if(result < 0 && errno == EINTR)
+                continue;
+
+            if(result <= 0)
+                break;
+
+            readBytes += result;
+
+        }
+
+        // Un error de lectura se avisa al programa cuando haya consumido los buffers anteriores
+        pthread_mutex_lock(&inputReader->mutex);
+
+        if(result < 0)
+            inputReader->failed = 1;
+        else if(readBytes > 0){
+
+            inputReader->buffersLength[buffer] = readBytes;
+            inputReader->readyBuffersNumber++;
+
+        }
+
+        if(result <= 0)
+            inputReader->endOfFile = 1;
+
+        pthread_cond_signal(&inputReader->bufferRead);
+        pthread_mutex_unlock(&inputReader->mutex);
+
+        if(result <= 0)
+            break;
+
+    }
+
+    return NULL;
+
+}
+
+// readInputReader
+size_t readInputReader(InputReader_s *inputReader, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    size_t copiedBytes = 0;
+    int buffer = 0;
+
+    // Esperamos a que el hilo lector tenga un buffer listo (Si ha llegado al final y no queda ninguno no hay más bytes)
+    pthread_mutex_lock(&inputReader->mutex);
+
+    while(inputReader->readyBuffersNumber == 0 && !inputReader->endOfFile)
+        pthread_cond_wait(&inputReader->bufferRead, &inputReader->mutex);
+
+    if(inputReader->readyBuffersNumber == 0){
+
+        pthread_mutex_unlock(&inputReader->mutex);
+
+        if(inputReader->failed){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al leer el fichero de entrada.\n");
+            exit(1);
+
+        }
+
+        return 0;
+
+    }
+
+    buffer = inputReader->firstBuffer;
+    pthread_mutex_unlock(&inputReader->mutex);
+
+    // Copiamos lo que quepa del buffer más antiguo
+    copiedBytes = inputReader->buffersLength[buffer] - inputReader->firstBufferPosition;
+
+    if(copiedBytes > capacity)
+        copiedBytes = capacity;
+
+    memcpy(destination, inputReader->buffers[buffer] + inputReader->firstBufferPosition, copiedBytes);
+    inputReader->firstBufferPosition += copiedBytes;
+
+    // Si lo hemos vaciado se lo devolvemos al hilo lector
+    if(inputReader->firstBufferPosition == inputReader->buffersLength[buffer]){
+
+        pthread_mutex_lock(&inputReader->mutex);
+        inputReader->firstBuffer = (inputReader->firstBuffer + 1) % IO_BUFFERS_NUMBER;
+        inputReader->firstBufferPosition = 0;
+        inputReader->readyBuffersNumber--;
+        pthread_cond_signal(&inputReader->bufferConsumed);
+        pthread_mutex_unlock(&inputReader->mutex);
+
+    }
+
+    return copiedBytes;
+
+}
+
+// takeInputReaderBuffer
+size_t takeInputReaderBuffer(InputReader_s *inputReader, byte **buffer){
+
+    // Variables necesarias
+    byte *readBuffer = NULL;
+    size_t readLength = 0;
+
+    // Esperamos a que el hilo lector tenga un buffer listo (Si ha llegado al final y no queda ninguno no hay más bytes)
+    pthread_mutex_lock(&inputReader->mutex);
+
+    while(inputReader->readyBuffersNumber == 0 && !inputReader->endOfFile)
+        pthread_cond_wait(&inputReader->bufferRead, &inputReader->mutex);
+
+    if(inputReader->readyBuffersNumber == 0){
+
+        pthread_mutex_unlock(&inputReader->mutex);
+
+        if(inputReader->failed){
+
+            fprintf(stderr, "ERROR: Ha ocurrido un error al leer el fichero de entrada.\n");
+            exit(1);
+
+        }
+
+        return 0;
+
+    }
+
+    // Cambiamos el buffer leído por el del programa (Del mismo tamaño), así no copiamos nada
+    readBuffer = inputReader->buffers[inputReader->firstBuffer];
+    readLength = inputReader->buffersLength[inputReader->firstBuffer];
+    inputReader->buffers[inputReader->firstBuffer] = *buffer;
+
+    inputReader->firstBuffer = (inputReader->firstBuffer + 1) % IO_BUFFERS_NUMBER;
+    inputReader->readyBuffersNumber--;
+    pthread_cond_signal(&inputReader->bufferConsumed);
+    pthread_mutex_unlock(&inputReader->mutex);
+
+    *buffer = readBuffer;
+
+    return readLength;
+
+}
+
+// stopInputReader
+void stopInputReader(InputReader_s *inputReader){
+
+    // Pedimos al hilo lector que termine y esperamos por él (Si está leyendo termina al acabar esa lectura)
+    pthread_mutex_lock(&inputReader->mutex);
+    inputReader->finish = 1;
+    pthread_cond_signal(&inputReader->bufferConsumed);
+    pthread_mutex_unlock(&inputReader->mutex);
+
+    pthread_join(inputReader->thread, NULL);
+
+    // Liberamos la memoria utilizada
+    pthread_mutex_destroy(&inputReader->mutex);
+    pthread_cond_destroy(&inputReader->bufferRead);
+    pthread_cond_destroy(&inputReader->bufferConsumed);
+
+    for(int i = 0; i < IO_BUFFERS_NUMBER; i++)
+        free(inputReader->buffers[i]);
+
+    free(inputReader);
+
+}
+
+// startOutputWriter
+OutputWriter_s* startOutputWriter(FILE *file, size_t bufferCapacity){
+
+    // Variables necesarias
+    OutputWriter_s *outputWriter = NULL;
+
+    // Vaciamos lo que haya escrito la biblioteca estándar, a partir de aquí el hilo escribe directamente en el descriptor
+    if(fflush(file) != 0){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero de salida.\n");
+        exit(1);
+
+    }
+
+    // Los buffers libres empiezan con la capacidad indicada, así el programa puede llenar el que recibe a cambio sin ampliarlo
+    outputWriter = (OutputWriter_s*)calloc(1, sizeof(OutputWriter_s));
+    outputWriter->fileDescriptor = fileno(file);
+
+    for(int i = 0; i < IO_BUFFERS_NUMBER; i++){
+
+        outputWriter->buffers[i] = (byte*)malloc(bufferCapacity);
+        outputWriter->buffersCapacity[i] = bufferCapacity;
+
+    }
+
+    pthread_mutex_init(&outputWriter->mutex, NULL);
+    pthread_cond_init(&outputWriter->bufferQueued, NULL);
+    pthread_cond_init(&outputWriter->bufferWritten, NULL);
+
+    if(pthread_create(&outputWriter->thread, NULL, outputWriterThread, outputWriter) != 0){
+
+        fprintf(stderr, "ERROR: No se ha podido crear el hilo escritor.\n");
+        exit(1);
+
+    }
+
+    return outputWriter;
+
+}
+
+// outputWriterThread
+void* outputWriterThread(void *arg){
+
+    // Variables necesarias
+    OutputWriter_s *outputWriter = (OutputWriter_s*)arg;
+    size_t writtenBytes = 0;
+    ssize_t result = 0;
+    int buffer = 0;
+
+    while(1){
+
+        // Esperamos a que haya algún buffer en la cola o a que nos pidan terminar
+        pthread_mutex_lock(&outputWriter->mutex);
+
+        while(outputWriter->pendingBuffersNumber == 0 && !outputWriter->finish)
+            pthread_cond_wait(&outputWriter->bufferQueued, &outputWriter->mutex);
+
+        if(outputWriter->pendingBuffersNumber == 0){
+
+            pthread_mutex_unlock(&outputWriter->mutex);
+            break;
+
+        }
+
+        buffer = outputWriter->firstBuffer;
+        pthread_mutex_unlock(&outputWriter->mutex);
+
+        // Escribimos el buffer más antiguo fuera del cerrojo (Tras un error descartamos el resto)
+        writtenBytes = 0;
+
+        while(!outputWriter->failed && writtenBytes < outputWriter->buffersLength[buffer]){
+
+            result = write(outputWriter->fileDescriptor, outputWriter->buffers[buffer] + writtenBytes, outputWriter->buffersLength[buffer] - writtenBytes);
+
+            if(result < 0 && errno == EINTR)
+                continue;
+
+            if(result <= 0)
+                break;
+
+            writtenBytes += result;
+
+        }
+
+        // Dejamos el buffer libre y avisamos al programa
+        pthread_mutex_lock(&outputWriter->mutex);
+
+        if(writtenBytes < outputWriter->buffersLength[buffer])
+            outputWriter->failed = 1;
+
+        outputWriter->firstBuffer = (outputWriter->firstBuffer + 1) % IO_BUFFERS_NUMBER;
+        outputWriter->pendingBuffersNumber--;
+        pthread_cond_signal(&outputWriter->bufferWritten);
+        pthread_mutex_unlock(&outputWriter->mutex);
+
+    }
+
+    return NULL;
+
+}
+
+// queueOutputBuffer
+void queueOutputBuffer(OutputWriter_s *outputWriter, byte **buffer, size_t *capacity, size_t length){
+
+    // Variables necesarias
+    byte *freeBuffer = NULL;
+    size_t freeCapacity = 0;
+    int slot = 0;
+
+    // Esperamos a que quede algún buffer libre (Si la escritura va por detrás el programa se frena aquí)
+    pthread_mutex_lock(&outputWriter->mutex);
+
+    while(outputWriter->pendingBuffersNumber == IO_BUFFERS_NUMBER && !outputWriter->failed)
+        pthread_cond_wait(&outputWriter->bufferWritten, &outputWriter->mutex);
+
+    if(outputWriter->failed){
+
+        fprintf(stderr, "ERROR: Ha ocurrido un error al escribir el fichero de salida.\n");
+        exit(1);
+
+    }
+
+    // Cambiamos el buffer del programa por el libre, así no copiamos nada
+    slot = (outputWriter->firstBuffer + outputWriter->pendingBuffersNumber) % IO_BUFFERS_NUMBER;
+    freeBuffer = outputWriter->buffers[slot];
+    freeCapacity = outputWriter->buffersCapacity[slot];
+
+    outputWriter->buffers[slot] = *buffer;
+    outputWriter->buffersCapacity[slot] = *capacity;
+    outputWriter->buffersLength[slot] = length;
+    outputWriter->pendingBuffersNumber++;
+
+    pthread_cond_signal(&outputWriter->bufferQueued);
+    pthread_mutex_unlock(&outputWriter->mutex);
+
+    *buffer = freeBuffer;
+    *capacity = freeCapacity;
+
+}
+
+// finishOutputWriter
+int finishOutputWriter(OutputWriter_s *outputWriter){
+
+    // Variables necesarias
+    int failed = 0;
+
+    // Pedimos al hilo escritor que termine en cuanto vacíe la cola y esperamos por él
+    pthread_mutex_lock(&outputWriter->mutex);
+    outputWriter->finish = 1;
+    pthread_cond_signal(&outputWriter->bufferQueued);
+    pthread_mutex_unlock(&outputWriter->mutex);
+
+    pthread_join(outputWriter->thread, NULL);
+    failed = outputWriter->failed;
+
+    // Liberamos la memoria utilizada
+    pthread_mutex_destroy(&outputWriter->mutex);
+    pthread_cond_destroy(&outputWriter->bufferQueued);
+    pthread_cond_destroy(&outputWriter->bufferWritten);
+
+    for(int i = 0; i < IO_BUFFERS_NUMBER; i++)
+        free(outputWriter->buffers[i]);
+
+    free(outputWriter);
+
+    return !failed;
+
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+    Título: Entrada y salida
+    Nombre: Héctor Paredes Benavides
+    Descripción: Entrada proyectada o con lectura adelantada y salida con un hilo escritor, comunes a cifrar y descifrar
+    Fecha: 16/10/2026
+*/
+
+#ifndef ENTRADA_SALIDA_H
+#define ENTRADA_SALIDA_H
+
+/* Instrucciones de Preprocesado */
+// Inclusión de bibliotecas externas
+#include <stdio.h>
+#include <pthread.h>
+
+// Inclusión de bibliotecas propias
+#include "huffman.h"
+
+// Definición de constantes
+#define IO_BUFFERS_NUMBER 3
+
+// Etapas que mide el propio programa (El resto las mide la biblioteca)
+#define STAGE_START 0
+#define STAGE_READ 1
+#define STAGE_WRITE 2
+
+/* Declaraciones Globales */
+// Estructuras
+// Un hilo lee la entrada por delante del programa en un anillo de buffers (Solo si no está proyectada)
+typedef struct InputReader_s{
+
+    FILE *file;
+    pthread_t thread;
+    unsigned char *buffers[IO_BUFFERS_NUMBER];
+    size_t buffersLength[IO_BUFFERS_NUMBER];
+    size_t bufferSize;
+    int firstBuffer;
+    size_t firstBufferPosition;
+    int readyBuffersNumber;
+    int endOfFile;
+    int failed;
+    int finish;
+    pthread_mutex_t mutex;
+    pthread_cond_t bufferRead;
+    pthread_cond_t bufferConsumed;
+
+}InputReader_s;
+
+// Un hilo escribe los buffers que le entrega el programa en orden, a cambio le devuelve buffers ya escritos
+typedef struct OutputWriter_s{
+
+    int fileDescriptor;
+    pthread_t thread;
+    unsigned char *buffers[IO_BUFFERS_NUMBER];
+    size_t buffersCapacity[IO_BUFFERS_NUMBER];
+    size_t buffersLength[IO_BUFFERS_NUMBER];
+    int firstBuffer;
+    int pendingBuffersNumber;
+    int failed;
+    int finish;
+    pthread_mutex_t mutex;
+    pthread_cond_t bufferQueued;
+    pthread_cond_t bufferWritten;
+
+}OutputWriter_s;
+
+// Fichero de entrada proyectado en memoria o, si no se puede, leído en un buffer que crece según haga falta
+typedef struct InputFile_s{
+
+    FILE *file;
+    InputReader_s *reader;
+    unsigned char *content;
+    size_t length;
+    size_t position;
+    size_t capacity;
+    int isMapped;
+
+}InputFile_s;
+
+// Prototipado de Funciones
+// Funciones de estadísticas
+void measureProgramStage(HuffmanStats_s *stats, HuffmanStageClock_s *stageClock, int stage);
+
+// Funciones de entrada
+InputFile_s openInputFile(char *fileName, size_t bufferSize);
+int tryOpenInputFile(InputFile_s *inputFile, char *fileName, size_t bufferSize);
+size_t ensureInputBytes(InputFile_s *inputFile, size_t bytesNumber);
+void prefetchInputBytes(InputFile_s *inputFile, size_t offset, size_t bytesNumber);
+void closeInputFile(InputFile_s inputFile);
+
+// Funciones de entrada y salida asíncrona
+// Con hilo lector el programa puede copiar lo leído con ensureInputBytes o quedarse con cada buffer entero con takeInputReaderBuffer
+void startInputReader(InputFile_s *inputFile, size_t bufferSize);
+void* inputReaderThread(void *arg);
+size_t readInputReader(InputReader_s *inputReader, unsigned char *destination, size_t capacity);
+size_t takeInputReaderBuffer(InputReader_s *inputReader, unsigned char **buffer);
+void stopInputReader(InputReader_s *inputReader);
+OutputWriter_s* startOutputWriter(FILE *file, size_t bufferCapacity);
+void* outputWriterThread(void *arg);
+void queueOutputBuffer(OutputWriter_s *outputWriter, unsigned char **buffer, size_t *capacity, size_t length);
+int finishOutputWriter(OutputWriter_s *outputWriter);
+
+#endif
@@ -0,0 +1,5145 @@
+/*
+    Título: Huffman
+    Nombre: Héctor Paredes Benavides
+    Descripción: Biblioteca para cifrar y descifrar buffers en memoria con el algoritmo de Huffman
+    Fecha: 16/10/2026
+*/
+
+/* Instrucciones de Preprocesado */
+// Inclusión de bibliotecas externas
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+
+// Inclusión de bibliotecas propias
+#include "huffman.h"
+
+// Definición de constantes
+#define byte unsigned char
+#define SYMBOLS_NUMBER 256
+#define CODE_LENGTHS_HEADER_START 5
+#define CODE_LENGTHS_HEADER_MAX (CODE_LENGTHS_HEADER_START + SYMBOLS_NUMBER)
+#define BITS_IN_BYTE 8
+#define BIT_BUFFER_FLUSH_BITS 32
+#define BIT_BUFFER_BITS 64
+#define DECODE_TABLE_BITS 11
+#define MAX_CODE_LENGTH HUFFMAN_MAX_CODE_LENGTH_LIMIT
+#define KIBIBYTE 1024
+#define HISTOGRAM_TABLES_NUMBER 4
+#define HISTOGRAM_SPLIT_MIN_LENGTH (256 * KIBIBYTE)
+#define TREE_NODES_NUMBER (2 * SYMBOLS_NUMBER - 1)
+#define TREE_NO_CHILD 0
+#define INDEX_MARKER 0xFFFFFFFFU
+#define CONTAINER_MAGIC "HUFF"
+#define CONTAINER_MAGIC_LENGTH 4
+#define CONTAINER_VERSION 1
+#define MULTI_STREAM_FLAG 0x80000000U
+#define STREAM_MIN_LENGTH KIBIBYTE
+#define STREAMS_HEADER_MAX (1 + (HUFFMAN_MAX_STREAMS_NUMBER - 1) * sizeof(unsigned int))
+#define FAST_DECODE_MARGIN (2 * sizeof(unsigned long long))
+#define FAST_DECODE_BYTES (2 * MAX_CODE_LENGTH / BITS_IN_BYTE)
+#define ADAPTIVE_FIRST_REBUILD_INTERVAL 256
+#define ADAPTIVE_MAX_REBUILD_INTERVAL (16 * KIBIBYTE)
+#define ADAPTIVE_MAX_TOTAL_COUNT (64 * KIBIBYTE)
+#define ADAPTIVE_CHUNK_HEADER_LENGTH (2 * sizeof(unsigned int))
+#define STATIC_TABLE_MAGIC "HUFT"
+#define STATIC_TABLE_VERSION 1
+#define STATIC_TABLE_MAX_TOTAL_COUNT (1U << 30)
+#define CONTEXT_MIN_SYMBOLS 64
+#define CONTEXT_BITMAP_LENGTH (SYMBOLS_NUMBER / BITS_IN_BYTE)
+#define CONTEXT_HEADER_MAX (CONTEXT_BITMAP_LENGTH + (SYMBOLS_NUMBER + 1) * CODE_LENGTHS_HEADER_MAX)
+#define TRANSFORM_BITS 4
+#define TRANSFORM_MASK 0x0F
+#define TRANSFORM_RECORD_LENGTH (2 * sizeof(unsigned int))
+#define TRANSFORM_FRAME_MAX (2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + HUFFMAN_MAX_TRANSFORMS_NUMBER * TRANSFORM_RECORD_LENGTH)
+#define RLE_RUN_LENGTH 4
+#define RLE_MAX_EXTRA_LENGTH 255
+#define SUFFIX_SYMBOL(content, symbolSize, i) (((symbolSize) == 1) ? ((const byte*)(content))[i] : ((const int*)(content))[i])
+#define SUFFIX_IS_LMS(types, i) ((i) > 0 && (types)[i] && !(types)[(i) - 1])
+#define LZ_BLOCK_MARKER SYMBOLS_NUMBER
+#define LZ_TABLES_NUMBER 3
+#define LZ_TOKENS_TABLE 0
+#define LZ_LITERALS_TABLE 1
+#define LZ_DISTANCES_TABLE 2
+#define LZ_HASH_BITS 16
+#define LZ_MIN_MATCH_LENGTH 3
+#define LZ_DIRECT_VALUES 8
+#define LZ_VALUE_EXTRA_BASE 5
+#define LZ_MAX_VALUE 2047
+#define LZ_MAX_MATCH_LENGTH (LZ_MAX_VALUE + LZ_MIN_MATCH_LENGTH - 1)
+#define LZ_DIRECT_DISTANCES 4
+#define LZ_DISTANCE_CODES_NUMBER (2 * HUFFMAN_MAX_WINDOW_BITS)
+#define CHECKPOINT_BLOCK_MARKER (SYMBOLS_NUMBER + 1)
+#define CHECKPOINT_RECORD_LENGTH (sizeof(unsigned long long) + 1)
+#define CHECKPOINT_FRAME_START (3 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START)
+
+// Tipos de bloque según su cabecera de longitudes (Los transformados y los de puntos de acceso envuelven a uno de estos)
+#define BLOCK_TYPE_NORMAL 0
+#define BLOCK_TYPE_STATIC 1
+#define BLOCK_TYPE_CONTEXT 2
+#define BLOCK_TYPE_LZ 3
+
+/* Declaraciones Globales */
+// Estructuras
+typedef struct StringCharacter_s{
+
+    unsigned char character;
+    int frequency;
+
+}StringCharacter_s;
+
+typedef struct TreeNode_s{
+
+    StringCharacter_s stringCharacter;
+    unsigned short leftChild;
+    unsigned short rightChild;
+
+}TreeNode_s;
+
+typedef struct HuffmanTree_s{
+
+    TreeNode_s nodes[TREE_NODES_NUMBER];
+    TreeNode_s mergedNodes[TREE_NODES_NUMBER];
+    int nodesNumber;
+
+}HuffmanTree_s;
+
+typedef struct HuffmanCode_s{
+
+    unsigned char character;
+    unsigned int code;
+    int codeLength;
+
+}HuffmanCode_s;
+
+typedef struct HistogramPart_s{
+
+    const byte *content;
+    size_t length;
+    int isThreaded;
+    unsigned int frequencyTable[SYMBOLS_NUMBER];
+
+}HistogramPart_s;
+
+typedef struct PackageItem_s{
+
+    unsigned long long weight;
+    int isPackage;
+    int leafIndex;
+
+}PackageItem_s;
+
+typedef struct DecodeEntry_s{
+
+    unsigned int value;
+    unsigned char length;
+    unsigned char isLink;
+
+}DecodeEntry_s;
+
+typedef struct DecodeTable_s{
+
+    int primaryBits;
+    int entriesNumber;
+    int capacity;
+    DecodeEntry_s *entries;
+
+}DecodeTable_s;
+
+typedef struct BitReader_s{
+
+    const byte *position;
+    const byte *end;
+    unsigned long long bitBuffer;
+    int bitsAvailable;
+
+}BitReader_s;
+
+typedef struct BitWriter_s{
+
+    byte *position;
+    unsigned long long bitBuffer;
+    int bitsInBuffer;
+
+}BitWriter_s;
+
+typedef struct LzSequence_s{
+
+    int literalsLength;
+    int matchLength;
+    int distance;
+
+}LzSequence_s;
+
+typedef struct LzLevel_s{
+
+    int chainLength;
+    int niceLength;
+    int isLazy;
+
+}LzLevel_s;
+
+typedef struct StaticTable_s{
+
+    int codesMaxLength;
+    DecodeTable_s decodeTable;
+
+}StaticTable_s;
+
+// Longitudes de código de las tablas estáticas de la biblioteca (En el orden de sus identificadores)
+// Se calcularon con huffmanBuildStaticTable limitadas a 12 bits, así sirven con cualquier longitud máxima a partir de 12
+static const byte builtinStaticTables[HUFFMAN_BUILTIN_TABLES_NUMBER][SYMBOLS_NUMBER] = {
+    // HUFFMAN_TABLE_TEXT: texto en inglés y en español (UTF-8)
+    {12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 6, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     3, 12, 9, 12, 12, 12, 12, 11, 9, 9, 10, 12, 7, 9, 7, 11, 11, 10, 10, 11, 12, 12, 12, 12, 12, 12, 11, 11, 12, 12, 12, 12,
+     12, 8, 10, 8, 9, 8, 9, 9, 9, 8, 12, 12, 7, 9, 8, 8, 8, 12, 8, 8, 8, 9, 10, 10, 12, 9, 12, 12, 12, 12, 12, 11,
+     10, 4, 6, 5, 5, 4, 6, 7, 5, 4, 11, 8, 5, 6, 4, 4, 6, 10, 4, 5, 4, 6, 7, 7, 9, 6, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12},
+    // HUFFMAN_TABLE_LOGS: registros de servidores y aplicaciones
+    {12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 12, 12, 9, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     4, 12, 6, 12, 12, 12, 12, 12, 8, 8, 12, 8, 10, 5, 5, 6, 4, 4, 4, 6, 5, 6, 5, 6, 6, 7, 5, 9, 10, 7, 10, 12,
+     12, 12, 12, 12, 11, 9, 10, 9, 9, 10, 12, 12, 10, 10, 9, 8, 8, 12, 10, 10, 7, 10, 12, 9, 11, 12, 9, 8, 12, 8, 12, 7,
+     12, 5, 6, 6, 5, 5, 8, 7, 8, 5, 10, 7, 6, 6, 6, 6, 7, 9, 6, 5, 5, 6, 8, 8, 8, 9, 9, 12, 12, 12, 11, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+     12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12}
+};
+
+// Parámetros de búsqueda de cada nivel de LZ77: candidatos que se miran en la cadena, longitud con la que se deja de buscar
+// y si se comprueba si la siguiente posición tiene una coincidencia más larga antes de aceptar una
+static const LzLevel_s lzLevels[HUFFMAN_MAX_LZ77_LEVEL + 1] = {
+    {0, 0, 0}, {4, 16, 0}, {8, 32, 0}, {16, 64, 0}, {16, 64, 1}, {32, 128, 1}, {64, 128, 1}, {128, 256, 1}, {512, 1024, 1}, {1024, LZ_MAX_MATCH_LENGTH, 1}
+};
+
+struct HuffmanEncoder_s{
+
+    int blockSize;
+    int maxCodeLength;
+    int threadsNumber;
+    int streamsNumber;
+    unsigned int frequencyTable[SYMBOLS_NUMBER];
+    StringCharacter_s sortedCharacters[SYMBOLS_NUMBER];
+    int charactersNumber;
+    HuffmanTree_s huffmanTree;
+    HuffmanCode_s huffmanCodes[SYMBOLS_NUMBER];
+    PackageItem_s *packageItems;
+    pthread_t *histogramThreads;
+    HistogramPart_s *histogramParts;
+    HuffmanBlockIndexEntry_s *blockIndex;
+    int blockIndexCapacity;
+    int staticTableId;
+    HuffmanCode_s staticCodes[SYMBOLS_NUMBER];
+    int staticCodesMaxLength;
+    int contextOrder;
+    unsigned int *contextFrequencyTables;
+    HuffmanCode_s *contextCodes;
+    int transforms[HUFFMAN_MAX_TRANSFORMS_NUMBER];
+    int transformsNumber;
+    int transformCapacity;
+    byte *transformBuffers[2];
+    int *suffixArray;
+    int *suffixRanks;
+    int *suffixTemp;
+    int *suffixCounts;
+    int lzLevel;
+    int lzWindowBits;
+    int lzCapacity;
+    int *lzHead;
+    int *lzPrevious;
+    LzSequence_s *lzSequences;
+    int checkpointInterval;
+    HuffmanStats_s *stats;
+
+};
+
+struct HuffmanDecoder_s{
+
+    int codeLengths[SYMBOLS_NUMBER];
+    HuffmanTree_s huffmanTree;
+    DecodeTable_s decodeTable;
+    HuffmanAdaptiveModel_s *adaptiveModel;
+    StaticTable_s *staticTables[HUFFMAN_MAX_TABLE_ID + 1];
+    DecodeTable_s *contextDecodeTables;
+    DecodeTable_s *contextTables[SYMBOLS_NUMBER];
+    int transformCapacity;
+    byte *transformBuffers[2];
+    unsigned long long *transformRows;
+    DecodeTable_s lzDecodeTables[LZ_TABLES_NUMBER];
+    byte *rangeBuffer;
+    int rangeCapacity;
+    HuffmanStats_s *stats;
+
+};
+
+// El modelo adaptativo cuenta los bytes ya cifrados o descifrados y cada cierto número de ellos rehace los códigos
+// con esas cuentas, así que cifrado y descifrado llegan siempre a los mismos códigos sin guardarlos en el fichero
+struct HuffmanAdaptiveModel_s{
+
+    HuffmanEncoder_s *encoder;
+    unsigned int symbolCounts[SYMBOLS_NUMBER];
+    unsigned int totalCount;
+    int rebuildInterval;
+    int symbolsUntilRebuild;
+    int codesMaxLength;
+    int codeLengths[SYMBOLS_NUMBER];
+    HuffmanTree_s huffmanTree;
+    DecodeTable_s decodeTable;
+    int hasDecodeTable;
+    HuffmanStats_s *stats;
+
+};
+
+// Prototipado de Funciones
+// Funciones Histograma
+static void countFrequencies(const byte *content, size_t length, unsigned int *frequencyTable);
+static void countContextFrequencies(const byte *content, size_t length, unsigned int *contextFrequencyTables, unsigned int *frequencyTable);
+static void countFrequenciesInParallel(HuffmanEncoder_s *encoder, const byte *content, size_t length);
+static void* histogramWorker(void *arg);
+
+// Funciones Caracteres Ordenados
+static int sortCharactersByFrequency(unsigned int *frequencyTable, StringCharacter_s *sortedCharacters);
+static int compareCharacters(const void *firstCharacter, const void *secondCharacter);
+
+// Funciones Árboles
+static void buildTree(StringCharacter_s *sortedCharacters, int charactersNumber, HuffmanTree_s *huffmanTree);
+static int buildTreeFromCodeLengths(int *codeLengths, HuffmanTree_s *huffmanTree);
+static int getTreeDepth(HuffmanTree_s *huffmanTree, int node);
+
+// Funciones algoritmo de Huffman
+static void initHuffmanCodes(HuffmanCode_s *huffmanCodes);
+static int generateHuffmanCodes(HuffmanCode_s *huffmanCodes, HuffmanTree_s *huffmanTree);
+static void assignCanonicalCodes(HuffmanCode_s *huffmanCodes, int maxCodeLength);
+static int limitCodeLengths(HuffmanEncoder_s *encoder);
+static int buildCodesFromFrequencies(HuffmanEncoder_s *encoder, const unsigned int *frequencyTable, HuffmanCode_s *huffmanCodes);
+static int packCodeLengths(HuffmanCode_s *huffmanCodes, byte *buffer);
+static long long encodeEntropyBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity);
+static long long encodeStaticBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity);
+static int encodeBlock(const byte *blockContent, int blockLength, HuffmanCode_s *huffmanCodes, int staticTableId, int streamsNumber, byte *encodedBlock);
+static int encodeStream(const byte *streamContent, int streamLength, HuffmanCode_s *huffmanCodes, byte *encodedStream);
+static inline __attribute__((always_inline)) void writeCode(BitWriter_s *bitWriter, HuffmanCode_s huffmanCode);
+static void flushBitWriter(BitWriter_s *bitWriter);
+static int getCodeLengthsHeaderLength(const byte *buffer, size_t bufferLength);
+static int unpackCodeLengths(const byte *buffer, int *codeLengths);
+static long long decodeEntropyBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity);
+static int loadBlockTables(HuffmanDecoder_s *decoder, const byte *frame, int headerLength, DecodeTable_s **decodeTable, int *codesMaxLength);
+static void decodeBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *decodeTable, byte *decodedContent);
+static int decodeStreams(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *decodeTable, byte *decodedContent);
+static int decodeFourStreams(BitReader_s *bitReaders, int segmentLength, int lastSegmentLength, DecodeTable_s *decodeTable, byte *decodedContent);
+
+// Funciones Contextos de orden 1
+static long long encodeContextBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, size_t order0Length, byte *destination);
+static int loadContextTables(HuffmanDecoder_s *decoder, const byte *buffer, int length);
+static void decodeContextBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s **contextTables, byte *decodedContent);
+
+// Funciones LZ77
+static long long encodeLzBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, size_t order0Length, byte *destination);
+static int reserveLzBuffers(HuffmanEncoder_s *encoder, int length);
+static int findLzSequences(HuffmanEncoder_s *encoder, const byte *source, int sourceLength);
+static int findLzMatch(const byte *source, int sourceLength, int position, const int *head, const int *previous, int windowSize, int chainLength, int niceLength, int *distance);
+static void insertLzPosition(const byte *source, int position, int *head, int *previous);
+static void addLzSequence(LzSequence_s *sequences, int *sequencesNumber, int literalsLength, int matchLength, int distance);
+static inline __attribute__((always_inline)) unsigned int getLzHash(const byte *content);
+static inline __attribute__((always_inline)) int getLzValueCode(int value, int *extraBits);
+static inline __attribute__((always_inline)) int getLzDistanceCode(int distance, int *extraBits);
+static int loadLzTables(HuffmanDecoder_s *decoder, const byte *buffer, int length);
+static int decodeLzBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *lzTables, byte *decodedContent);
+static inline __attribute__((always_inline)) unsigned int readBits(BitReader_s *bitReader, int bitsNumber);
+
+// Funciones Transformaciones
+static long long encodeTransformedBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity);
+static long long decodeTransformedBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity);
+static int isTransformHeader(const byte *buffer);
+static int reserveEncoderTransforms(HuffmanEncoder_s *encoder, int length);
+static int reserveDecoderTransforms(HuffmanDecoder_s *decoder, int length);
+static int encodeRunLengths(const byte *source, int sourceLength, byte *destination);
+static int decodeRunLengths(const byte *source, int sourceLength, byte *destination, int capacity);
+static unsigned int encodeBurrowsWheeler(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination);
+static int decodeBurrowsWheeler(const byte *source, int sourceLength, unsigned int primaryIndex, unsigned long long *nextRows, byte *destination);
+static void buildSuffixArray(const byte *content, int length, int *suffixArray, int *ranks, int *temp, int *counts);
+static void sortSuffixes(const void *content, int symbolSize, int length, int alphabetSize, int *suffixArray, byte *types, int *buckets, int *nextBuckets);
+static void induceSuffixes(const void *content, int symbolSize, int length, int alphabetSize, int *suffixArray, const byte *types, int *buckets);
+static void getSuffixBuckets(const void *content, int symbolSize, int length, int alphabetSize, int *buckets, int bucketEnds);
+static void encodeMoveToFront(const byte *source, int sourceLength, byte *destination);
+static void decodeMoveToFront(const byte *source, int sourceLength, byte *destination);
+
+// Funciones Puntos de acceso
+static long long encodeCheckpointBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity);
+static long long decodeCheckpointBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity);
+static long long getCheckpointInnerFrame(const byte *frame, size_t frameLength, int *interval, const byte **innerFrame);
+static long long decodeBlockRange(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, int offset, int length, byte *destination);
+static int isCheckpointHeader(const byte *buffer);
+static long long getBlockIndexEntries(const byte *source, size_t sourceLength, const byte **indexEntries);
+
+// Funciones Lector de Bits
+static void initBitReader(BitReader_s *bitReader, const byte *content, int length);
+static int getFastIterations(BitReader_s *bitReader);
+static inline __attribute__((always_inline)) void loadBitReader(BitReader_s *bitReader);
+static inline __attribute__((always_inline)) void refillBitReader(BitReader_s *bitReader);
+static void refillBitReaderTail(BitReader_s *bitReader);
+static inline __attribute__((always_inline)) byte lookupSymbol(BitReader_s *bitReader, DecodeTable_s *decodeTable);
+static inline __attribute__((always_inline)) byte decodeSymbol(BitReader_s *bitReader, DecodeTable_s *decodeTable);
+
+// Funciones Modelo Adaptativo
+static void resetAdaptiveModel(HuffmanAdaptiveModel_s *model, int maxCodeLength);
+static void rebuildAdaptiveCodes(HuffmanAdaptiveModel_s *model);
+static long long decodeAdaptiveStream(HuffmanDecoder_s *decoder, const byte *source, size_t sourceLength, byte *destination, size_t capacity);
+
+// Funciones Tablas estáticas
+static int buildStaticTableTree(const byte *codeLengths, int maxCodeLength, int *treeCodeLengths, HuffmanTree_s *huffmanTree);
+
+// Funciones de tablas de descifrado
+static int buildDecodeTable(HuffmanTree_s *huffmanTree, DecodeTable_s *decodeTable);
+static int fillDecodeTable(DecodeTable_s *decodeTable, int tableOffset, int tableBits, HuffmanTree_s *huffmanTree, int node);
+static int reserveDecodeTable(DecodeTable_s *decodeTable, int entriesNumber);
+static void freeDecodeTable(DecodeTable_s *decodeTable);
+
+// Funciones auxiliares
+static void storeUInt32(byte *buffer, unsigned int value);
+static void storeUInt64(byte *buffer, unsigned long long value);
+static unsigned int loadUInt32(const byte *buffer);
+static unsigned long long loadUInt64(const byte *buffer);
+static void addStageTimes(HuffmanStageTimes_s *total, const HuffmanStageTimes_s *partial);
+
+/* Codificación de Funciones */
+
+// huffmanCreateEncoder
+HuffmanEncoder_s* huffmanCreateEncoder(int blockSize, int maxCodeLength, int threadsNumber){
+
+    // Variables necesarias
+    HuffmanEncoder_s *encoder = NULL;
+
+    if(blockSize < 1 || blockSize > HUFFMAN_MAX_BLOCK_SIZE || maxCodeLength < HUFFMAN_MIN_CODE_LENGTH_LIMIT || maxCodeLength > HUFFMAN_MAX_CODE_LENGTH_LIMIT || threadsNumber < 1)
+        return NULL;
+
+    // Todas las tablas del cifrado van dentro del contexto
+    encoder = (HuffmanEncoder_s*)calloc(1, sizeof(HuffmanEncoder_s));
+
+    if(encoder == NULL)
+        return NULL;
+
+    encoder->blockSize = blockSize;
+    encoder->maxCodeLength = maxCodeLength;
+    encoder->threadsNumber = threadsNumber;
+    encoder->streamsNumber = HUFFMAN_DEFAULT_STREAMS_NUMBER;
+    encoder->lzWindowBits = HUFFMAN_DEFAULT_WINDOW_BITS;
+
+    // Con varios hilos reservamos desde el principio lo necesario para repartir el histograma
+    if(threadsNumber > 1){
+
+        encoder->histogramThreads = (pthread_t*)malloc(threadsNumber * sizeof(pthread_t));
+        encoder->histogramParts = (HistogramPart_s*)malloc(threadsNumber * sizeof(HistogramPart_s));
+
+    }
+
+    return encoder;
+
+}
+
+// huffmanFreeEncoder
+void huffmanFreeEncoder(HuffmanEncoder_s *encoder){
+
+    if(encoder == NULL)
+        return;
+
+    free(encoder->packageItems);
+    free(encoder->histogramThreads);
+    free(encoder->histogramParts);
+    free(encoder->blockIndex);
+    free(encoder->contextFrequencyTables);
+    free(encoder->contextCodes);
+    free(encoder->transformBuffers[0]);
+    free(encoder->transformBuffers[1]);
+    free(encoder->suffixArray);
+    free(encoder->suffixRanks);
+    free(encoder->suffixTemp);
+    free(encoder->suffixCounts);
+    free(encoder->lzHead);
+    free(encoder->lzPrevious);
+    free(encoder->lzSequences);
+    free(encoder);
+
+}
+
+// huffmanEncodeBound
+size_t huffmanEncodeBound(size_t sourceLength, int blockSize, int maxCodeLength){
+
+    // Variables necesarias
+    size_t blocksNumber = 0;
+    size_t bound = 0;
+
+    // Cabecera, bloques completos, el último bloque y el índice
+    blocksNumber = (sourceLength + blockSize - 1) / blockSize;
+    bound = HUFFMAN_CONTAINER_HEADER_LENGTH + (sourceLength / blockSize) * huffmanEncodeBlockBound(blockSize, maxCodeLength);
+
+    if(sourceLength % blockSize != 0)
+        bound += huffmanEncodeBlockBound(sourceLength % blockSize, maxCodeLength);
+
+    return bound + huffmanBlockIndexLength(blocksNumber);
+
+}
+
+// huffmanEncode
+long long huffmanEncode(HuffmanEncoder_s *encoder, const byte *source, size_t sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    size_t sourcePosition = 0;
+    size_t destinationPosition = 0;
+    int blocksNumber = 0;
+    int blockLength = 0;
+    long long encodedBlockLength = 0;
+    HuffmanBlockIndexEntry_s *blockIndex = NULL;
+    int blockIndexCapacity = 0;
+
+    if(encoder == NULL || (source == NULL && sourceLength > 0) || destination == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(capacity < HUFFMAN_CONTAINER_HEADER_LENGTH)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    destinationPosition = huffmanWriteContainerHeader(destination, sourceLength, 0);
+
+    // Ciframos bloque a bloque anotando la posición de cada uno en el índice del contexto
+    while(1){
+
+        // El índice solo crece si esta llamada tiene más bloques que las anteriores
+        if(blocksNumber + 1 > encoder->blockIndexCapacity){
+
+            if(encoder->stats != NULL)
+                encoder->stats->allocationsNumber++;
+
+            blockIndexCapacity = (encoder->blockIndexCapacity > 0) ? encoder->blockIndexCapacity * 2 : 64;
+
+            if((blockIndex = (HuffmanBlockIndexEntry_s*)realloc(encoder->blockIndex, blockIndexCapacity * sizeof(HuffmanBlockIndexEntry_s))) == NULL)
+                return HUFFMAN_ERROR_CAPACITY;
+
+            encoder->blockIndex = blockIndex;
+            encoder->blockIndexCapacity = blockIndexCapacity;
+
+        }
+
+        encoder->blockIndex[blocksNumber].compressedOffset = destinationPosition;
+        encoder->blockIndex[blocksNumber].decodedOffset = sourcePosition;
+
+        if(sourcePosition == sourceLength)
+            break;
+
+        blockLength = (sourceLength - sourcePosition < (size_t)encoder->blockSize) ? (int)(sourceLength - sourcePosition) : encoder->blockSize;
+        encodedBlockLength = huffmanEncodeBlock(encoder, source + sourcePosition, blockLength, destination + destinationPosition, capacity - destinationPosition);
+
+        if(encodedBlockLength < 0)
+            return encodedBlockLength;
+
+        sourcePosition += blockLength;
+        destinationPosition += encodedBlockLength;
+        blocksNumber++;
+
+    }
+
+    // Terminamos con el índice de bloques
+    if(destinationPosition + huffmanBlockIndexLength(blocksNumber) > capacity)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    destinationPosition += huffmanWriteBlockIndex(destination + destinationPosition, encoder->blockIndex, blocksNumber, destinationPosition);
+
+    return destinationPosition;
+
+}
+
+// huffmanEncodeBlock
+long long huffmanEncodeBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    if(encoder == NULL || sourceLength < 0 || (source == NULL && sourceLength > 0) || destination == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Con transformaciones el bloque cifrado va dentro de un bloque que indica cómo deshacerlas
+    if(encoder->transformsNumber > 0 && sourceLength > 0)
+        return encodeTransformedBlock(encoder, source, sourceLength, destination, capacity);
+
+    // Con puntos de acceso el bloque cifrado va dentro de un bloque con su tabla (Si cabe en un intervalo no hace falta ninguno)
+    if(encoder->checkpointInterval > 0 && sourceLength > encoder->checkpointInterval)
+        return encodeCheckpointBlock(encoder, source, sourceLength, destination, capacity);
+
+    return encodeEntropyBlock(encoder, source, sourceLength, destination, capacity);
+
+}
+
+// huffmanSetEncoderStreams
+int huffmanSetEncoderStreams(HuffmanEncoder_s *encoder, int streamsNumber){
+
+    if(encoder == NULL || streamsNumber < 1 || streamsNumber > HUFFMAN_MAX_STREAMS_NUMBER)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Afecta a los bloques que se cifren a partir de ahora
+    encoder->streamsNumber = streamsNumber;
+
+    return 0;
+
+}
+
+// huffmanSetEncoderContextOrder
+int huffmanSetEncoderContextOrder(HuffmanEncoder_s *encoder, int contextOrder){
+
+    if(encoder == NULL || contextOrder < 0 || contextOrder > HUFFMAN_MAX_CONTEXT_ORDER)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Las cuentas por contexto y las tablas de cada contexto se reservan la primera vez y se reutilizan en todos los bloques
+    if(contextOrder == 1 && encoder->contextFrequencyTables == NULL){
+
+        encoder->contextFrequencyTables = (unsigned int*)malloc((size_t)SYMBOLS_NUMBER * SYMBOLS_NUMBER * sizeof(unsigned int));
+        encoder->contextCodes = (HuffmanCode_s*)malloc((size_t)(SYMBOLS_NUMBER + 1) * SYMBOLS_NUMBER * sizeof(HuffmanCode_s));
+
+        // Si falta alguna no dejamos nada reservado, así la siguiente llamada lo vuelve a intentar y el orden no cambia
+        if(encoder->contextFrequencyTables == NULL || encoder->contextCodes == NULL){
+
+            free(encoder->contextFrequencyTables);
+            free(encoder->contextCodes);
+            encoder->contextFrequencyTables = NULL;
+            encoder->contextCodes = NULL;
+
+            return HUFFMAN_ERROR_CAPACITY;
+
+        }
+
+        if(encoder->stats != NULL)
+            encoder->stats->allocationsNumber += 2;
+
+    }
+
+    // Afecta a los bloques que se cifren a partir de ahora (Una tabla estática tiene prioridad)
+    encoder->contextOrder = contextOrder;
+
+    return 0;
+
+}
+
+// huffmanSetEncoderTransforms
+int huffmanSetEncoderTransforms(HuffmanEncoder_s *encoder, const int *transforms, int transformsNumber){
+
+    if(encoder == NULL || transformsNumber < 0 || transformsNumber > HUFFMAN_MAX_TRANSFORMS_NUMBER || (transforms == NULL && transformsNumber > 0))
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    for(int i = 0; i < transformsNumber; i++)
+        if(transforms[i] < HUFFMAN_TRANSFORM_RLE || transforms[i] > HUFFMAN_TRANSFORM_MTF)
+            return HUFFMAN_ERROR_ARGUMENT;
+
+    // La memoria de las transformaciones se reserva en el primer bloque, cuando se conoce su longitud
+    for(int i = 0; i < transformsNumber; i++)
+        encoder->transforms[i] = transforms[i];
+
+    encoder->transformsNumber = transformsNumber;
+
+    return 0;
+
+}
+
+// huffmanSetEncoderLz77
+int huffmanSetEncoderLz77(HuffmanEncoder_s *encoder, int level, int windowBits){
+
+    if(encoder == NULL || level < 0 || level > HUFFMAN_MAX_LZ77_LEVEL || windowBits < HUFFMAN_MIN_WINDOW_BITS || windowBits > HUFFMAN_MAX_WINDOW_BITS)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Con el nivel 0 no se buscan coincidencias (La memoria de la búsqueda se reserva en el primer bloque)
+    encoder->lzLevel = level;
+    encoder->lzWindowBits = windowBits;
+
+    return 0;
+
+}
+
+// huffmanSetEncoderCheckpoints
+int huffmanSetEncoderCheckpoints(HuffmanEncoder_s *encoder, int interval){
+
+    if(encoder == NULL || (interval != 0 && (interval < HUFFMAN_MIN_CHECKPOINT_INTERVAL || interval > HUFFMAN_MAX_BLOCK_SIZE)))
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Con 0 los bloques no llevan puntos de acceso
+    encoder->checkpointInterval = interval;
+
+    return 0;
+
+}
+
+// huffmanCreateDecoder
+HuffmanDecoder_s* huffmanCreateDecoder(){
+
+    // El árbol va dentro del contexto y la tabla de descifrado se reserva en el primer bloque y se reutiliza
+    return (HuffmanDecoder_s*)calloc(1, sizeof(HuffmanDecoder_s));
+
+}
+
+// huffmanFreeDecoder
+void huffmanFreeDecoder(HuffmanDecoder_s *decoder){
+
+    if(decoder == NULL)
+        return;
+
+    freeDecodeTable(&decoder->decodeTable);
+    huffmanFreeAdaptiveModel(decoder->adaptiveModel);
+
+    if(decoder->contextDecodeTables != NULL){
+
+        for(int i = 0; i <= SYMBOLS_NUMBER; i++)
+            freeDecodeTable(&decoder->contextDecodeTables[i]);
+
+        free(decoder->contextDecodeTables);
+
+    }
+
+    for(int i = 0; i <= HUFFMAN_MAX_TABLE_ID; i++){
+
+        if(decoder->staticTables[i] != NULL){
+
+            freeDecodeTable(&decoder->staticTables[i]->decodeTable);
+            free(decoder->staticTables[i]);
+
+        }
+
+    }
+
+    free(decoder->transformBuffers[0]);
+    free(decoder->transformBuffers[1]);
+    free(decoder->transformRows);
+    free(decoder->rangeBuffer);
+
+    for(int i = 0; i < LZ_TABLES_NUMBER; i++)
+        freeDecodeTable(&decoder->lzDecodeTables[i]);
+
+    free(decoder);
+
+}
+
+// huffmanDecode
+long long huffmanDecode(HuffmanDecoder_s *decoder, const byte *source, size_t sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    unsigned long long originalSize = 0;
+    long long frameLength = 0;
+    long long decodedBlockLength = 0;
+    size_t sourcePosition = 0;
+    size_t decodedLength = 0;
+    int charactersNumber = 0;
+    int options = 0;
+
+    if(decoder == NULL || source == NULL || (destination == NULL && capacity > 0))
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Comprobamos la cabecera del contenedor
+    frameLength = huffmanReadContainerHeader(source, sourceLength, &originalSize, &options);
+
+    if(frameLength < 0)
+        return frameLength;
+
+    // Los flujos adaptativos no tienen bloques ni índice, solo trozos hasta la marca de final
+    if(options & HUFFMAN_OPTION_ADAPTIVE)
+        return decodeAdaptiveStream(decoder, source + frameLength, sourceLength - frameLength, destination, capacity);
+
+    sourcePosition = frameLength;
+
+    // Desciframos los bloques hasta la marca del índice o el final del buffer
+    while(sourcePosition < sourceLength){
+
+        frameLength = huffmanGetBlockFrameLength(source + sourcePosition, sourceLength - sourcePosition, &charactersNumber);
+
+        if(frameLength < 0)
+            return frameLength;
+
+        if(frameLength == 0)
+            break;
+
+        if((size_t)frameLength > sourceLength - sourcePosition)
+            return HUFFMAN_ERROR_INCOMPLETE;
+
+        decodedBlockLength = huffmanDecodeBlock(decoder, source + sourcePosition, frameLength, destination + decodedLength, capacity - decodedLength);
+
+        if(decodedBlockLength < 0)
+            return decodedBlockLength;
+
+        sourcePosition += frameLength;
+        decodedLength += decodedBlockLength;
+
+    }
+
+    // Si la cabecera indicaba el tamaño original comprobamos que coincide con lo descifrado
+    if(originalSize != HUFFMAN_UNKNOWN_ORIGINAL_SIZE && decodedLength != originalSize)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    return decodedLength;
+
+}
+
+// huffmanDecodeBlock
+long long huffmanDecodeBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity){
+
+    if(decoder == NULL || frame == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Un bloque transformado lleva dentro un bloque normal y las transformaciones que hay que deshacer después
+    if(frameLength >= sizeof(unsigned int) + CODE_LENGTHS_HEADER_START && isTransformHeader(frame + sizeof(unsigned int)))
+        return decodeTransformedBlock(decoder, frame, frameLength, destination, capacity);
+
+    // Para descifrar el bloque entero los puntos de acceso no hacen falta
+    if(frameLength >= sizeof(unsigned int) + CODE_LENGTHS_HEADER_START && isCheckpointHeader(frame + sizeof(unsigned int)))
+        return decodeCheckpointBlock(decoder, frame, frameLength, destination, capacity);
+
+    return decodeEntropyBlock(decoder, frame, frameLength, destination, capacity);
+
+}
+
+// huffmanDecodeRange
+long long huffmanDecodeRange(HuffmanDecoder_s *decoder, const byte *source, size_t sourceLength, unsigned long long offset, size_t length, byte *destination){
+
+    // Variables necesarias
+    const byte *indexEntries = NULL;
+    long long blocksNumber = 0;
+    long long status = 0;
+    int options = 0;
+    int first = 0;
+    int last = 0;
+    int middle = 0;
+    size_t decodedLength = 0;
+    unsigned long long blockStart = 0;
+    unsigned long long blockEnd = 0;
+    unsigned long long compressedStart = 0;
+    unsigned long long compressedEnd = 0;
+    int charactersNumber = 0;
+    int rangeLength = 0;
+
+    if(decoder == NULL || source == NULL || (destination == NULL && length > 0))
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Los flujos adaptativos no tienen índice, así que solo se pueden descifrar desde el principio
+    if((status = huffmanReadContainerHeader(source, sourceLength, NULL, &options)) < 0)
+        return status;
+
+    if(options & HUFFMAN_OPTION_ADAPTIVE)
+        return HUFFMAN_ERROR_FORMAT;
+
+    if((blocksNumber = getBlockIndexEntries(source, sourceLength, &indexEntries)) < 0)
+        return blocksNumber;
+
+    // Cada entrada son la posición cifrada y la descifrada de un bloque (La última es el final de ambos ficheros)
+    // Buscamos por bisección el último bloque que empieza antes de offset, sin leer el resto del índice
+    if(blocksNumber == 0 || offset >= loadUInt64(indexEntries + blocksNumber * 2 * sizeof(unsigned long long) + sizeof(unsigned long long)))
+        return 0;
+
+    first = 0;
+    last = blocksNumber - 1;
+
+    while(first < last){
+
+        middle = first + (last - first + 1) / 2;
+
+        if(loadUInt64(indexEntries + middle * 2 * sizeof(unsigned long long) + sizeof(unsigned long long)) <= offset)
+            first = middle;
+        else
+            last = middle - 1;
+
+    }
+
+    // Desciframos de cada bloque solo la parte del rango hasta completarlo o llegar al final del fichero
+    for(int i = first; i < blocksNumber && decodedLength < length; i++){
+
+        compressedStart = loadUInt64(indexEntries + i * 2 * sizeof(unsigned long long));
+        blockStart = loadUInt64(indexEntries + i * 2 * sizeof(unsigned long long) + sizeof(unsigned long long));
+        compressedEnd = loadUInt64(indexEntries + (i + 1) * 2 * sizeof(unsigned long long));
+        blockEnd = loadUInt64(indexEntries + (i + 1) * 2 * sizeof(unsigned long long) + sizeof(unsigned long long));
+
+        // Como el índice no se valida entero comprobamos las entradas que usamos
+        if(compressedStart < HUFFMAN_CONTAINER_HEADER_LENGTH || compressedEnd <= compressedStart || compressedEnd > (unsigned long long)(indexEntries - source) ||
+           blockEnd < blockStart || offset + decodedLength < blockStart)
+            return HUFFMAN_ERROR_FORMAT;
+
+        if(huffmanGetBlockFrameLength(source + compressedStart, compressedEnd - compressedStart, &charactersNumber) != (long long)(compressedEnd - compressedStart) ||
+           (unsigned long long)charactersNumber != blockEnd - blockStart)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        rangeLength = (blockEnd - (offset + decodedLength) < length - decodedLength) ? blockEnd - (offset + decodedLength) : length - decodedLength;
+
+        if(rangeLength == 0)
+            continue;
+
+        if((status = decodeBlockRange(decoder, source + compressedStart, compressedEnd - compressedStart, offset + decodedLength - blockStart, rangeLength, destination + decodedLength)) < 0)
+            return status;
+
+        decodedLength += rangeLength;
+
+    }
+
+    return decodedLength;
+
+}
+
+// huffmanWriteContainerHeader
+int huffmanWriteContainerHeader(byte *destination, unsigned long long originalSize, int options){
+
+    // Cabecera del contenedor: identificador, versión, opciones (HUFFMAN_OPTION_*) y tamaño original en 64 bits
+    // Todos los campos numéricos del formato son little endian para que el fichero sea portable entre máquinas
+    memcpy(destination, CONTAINER_MAGIC, CONTAINER_MAGIC_LENGTH);
+    destination[CONTAINER_MAGIC_LENGTH] = CONTAINER_VERSION;
+    destination[CONTAINER_MAGIC_LENGTH + 1] = options;
+    storeUInt64(destination + HUFFMAN_ORIGINAL_SIZE_OFFSET, originalSize);
+
+    return HUFFMAN_CONTAINER_HEADER_LENGTH;
+
+}
+
+// huffmanReadContainerHeader
+long long huffmanReadContainerHeader(const byte *source, size_t sourceLength, unsigned long long *originalSize, int *options){
+
+    if(sourceLength < HUFFMAN_CONTAINER_HEADER_LENGTH)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if(memcmp(source, CONTAINER_MAGIC, CONTAINER_MAGIC_LENGTH) != 0)
+        return HUFFMAN_ERROR_FORMAT;
+
+    // Una opción desconocida la trataríamos mal, así que se rechaza igual que otra versión
+    if(source[CONTAINER_MAGIC_LENGTH] != CONTAINER_VERSION || (source[CONTAINER_MAGIC_LENGTH + 1] & ~HUFFMAN_OPTION_ADAPTIVE) != 0)
+        return HUFFMAN_ERROR_VERSION;
+
+    if(originalSize != NULL)
+        *originalSize = loadUInt64(source + HUFFMAN_ORIGINAL_SIZE_OFFSET);
+
+    if(options != NULL)
+        *options = source[CONTAINER_MAGIC_LENGTH + 1];
+
+    return HUFFMAN_CONTAINER_HEADER_LENGTH;
+
+}
+
+// huffmanGetBlockFrameLength
+long long huffmanGetBlockFrameLength(const byte *source, size_t availableLength, int *charactersNumber){
+
+    // Variables necesarias
+    unsigned int blockHeaderValue = 0;
+    unsigned int payloadLength = 0;
+    int headerLength = 0;
+
+    // Bloque: cantidad de caracteres, cabecera de longitudes, longitud del contenido y contenido
+    // El bit más alto de la cantidad de caracteres indica que el contenido está repartido en varios flujos
+    // Mientras no haya bytes suficientes devolvemos cuántos hacen falta para seguir leyendo el bloque, que siempre son más de los que hay
+    if(availableLength < sizeof(unsigned int))
+        return sizeof(unsigned int);
+
+    // La marca del índice indica que ya no quedan bloques
+    blockHeaderValue = loadUInt32(source);
+
+    if(blockHeaderValue == INDEX_MARKER)
+        return 0;
+
+    if((blockHeaderValue & ~MULTI_STREAM_FLAG) > HUFFMAN_MAX_BLOCK_SIZE)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Cualquier bloque tiene al menos la cabecera de longitudes y la longitud del contenido, que en los bloques de orden 1
+    // es donde va la longitud de las tablas de contexto
+    if(availableLength < 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START)
+        return 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START;
+
+    headerLength = getCodeLengthsHeaderLength(source + sizeof(unsigned int), availableLength - sizeof(unsigned int));
+
+    if(headerLength < 0)
+        return headerLength;
+
+    if(availableLength < 2 * sizeof(unsigned int) + headerLength)
+        return 2 * sizeof(unsigned int) + headerLength;
+
+    payloadLength = loadUInt32(source + sizeof(unsigned int) + headerLength);
+
+    if(payloadLength > INT_MAX)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if(charactersNumber != NULL)
+        *charactersNumber = blockHeaderValue & ~MULTI_STREAM_FLAG;
+
+    return 2 * sizeof(unsigned int) + headerLength + (long long)payloadLength;
+
+}
+
+// huffmanBlockIndexLength
+size_t huffmanBlockIndexLength(int blocksNumber){
+
+    // Marca, número de bloques, las entradas (Una más que bloques) y la posición de la marca
+    return 2 * sizeof(unsigned int) + ((size_t)blocksNumber + 1) * 2 * sizeof(unsigned long long) + sizeof(unsigned long long);
+
+}
+
+// huffmanWriteBlockIndex
+size_t huffmanWriteBlockIndex(byte *destination, HuffmanBlockIndexEntry_s *entries, int blocksNumber, unsigned long long indexOffset){
+
+    // Variables necesarias
+    size_t indexLength = 0;
+
+    // La marca ocupa el lugar de la cantidad de caracteres de un bloque, así la lectura secuencial sabe dónde terminan
+    // Después van el número de bloques, las entradas (La última marca el final de ambos ficheros) y la posición de la marca al final del fichero
+    indexLength = huffmanBlockIndexLength(blocksNumber);
+
+    storeUInt32(destination, INDEX_MARKER);
+    storeUInt32(destination + sizeof(unsigned int), blocksNumber);
+
+    for(int i = 0; i <= blocksNumber; i++){
+
+        storeUInt64(destination + 2 * sizeof(unsigned int) + i * 2 * sizeof(unsigned long long), entries[i].compressedOffset);
+        storeUInt64(destination + 2 * sizeof(unsigned int) + i * 2 * sizeof(unsigned long long) + sizeof(unsigned long long), entries[i].decodedOffset);
+
+    }
+
+    storeUInt64(destination + indexLength - sizeof(unsigned long long), indexOffset);
+
+    return indexLength;
+
+}
+
+// huffmanReadBlockIndex
+long long huffmanReadBlockIndex(const byte *source, size_t sourceLength, HuffmanBlockIndexEntry_s *entries, int capacity){
+
+    // Variables necesarias
+    const byte *indexEntries = NULL;
+    long long blocksNumber = 0;
+    long long compressedOffset = 0;
+    long long decodedOffset = 0;
+    long long lastCompressedOffset = 0;
+    long long lastDecodedOffset = 0;
+
+    if((blocksNumber = getBlockIndexEntries(source, sourceLength, &indexEntries)) < 0)
+        return blocksNumber;
+
+    if(entries != NULL && capacity < (int)blocksNumber + 1)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    // Las posiciones deben ser crecientes, empezar tras la cabecera y terminar en el propio índice
+    for(int i = 0; i <= blocksNumber; i++){
+
+        compressedOffset = loadUInt64(indexEntries + i * 2 * sizeof(unsigned long long));
+        decodedOffset = loadUInt64(indexEntries + i * 2 * sizeof(unsigned long long) + sizeof(unsigned long long));
+
+        if(i == 0 && (compressedOffset != HUFFMAN_CONTAINER_HEADER_LENGTH || decodedOffset != 0))
+            return HUFFMAN_ERROR_FORMAT;
+
+        if(i > 0 && (compressedOffset <= lastCompressedOffset || decodedOffset < lastDecodedOffset))
+            return HUFFMAN_ERROR_FORMAT;
+
+        if(entries != NULL){
+
+            entries[i].compressedOffset = compressedOffset;
+            entries[i].decodedOffset = decodedOffset;
+
+        }
+
+        lastCompressedOffset = compressedOffset;
+        lastDecodedOffset = decodedOffset;
+
+    }
+
+    if(lastCompressedOffset != indexEntries - 2 * sizeof(unsigned int) - source)
+        return HUFFMAN_ERROR_FORMAT;
+
+    return blocksNumber;
+
+}
+
+// huffmanCreateAdaptiveModel
+HuffmanAdaptiveModel_s* huffmanCreateAdaptiveModel(int maxCodeLength){
+
+    // Variables necesarias
+    HuffmanAdaptiveModel_s *model = NULL;
+
+    if(maxCodeLength < HUFFMAN_MIN_CODE_LENGTH_LIMIT || maxCodeLength > HUFFMAN_MAX_CODE_LENGTH_LIMIT)
+        return NULL;
+
+    model = (HuffmanAdaptiveModel_s*)calloc(1, sizeof(HuffmanAdaptiveModel_s));
+
+    if(model == NULL)
+        return NULL;
+
+    // Las longitudes se calculan con las mismas funciones que en el cifrado por bloques, sobre un contexto de cifrado propio
+    if((model->encoder = huffmanCreateEncoder(HUFFMAN_DEFAULT_BLOCK_SIZE, maxCodeLength, 1)) == NULL){
+
+        free(model);
+        return NULL;
+
+    }
+
+    resetAdaptiveModel(model, maxCodeLength);
+
+    return model;
+
+}
+
+// huffmanFreeAdaptiveModel
+void huffmanFreeAdaptiveModel(HuffmanAdaptiveModel_s *model){
+
+    if(model == NULL)
+        return;
+
+    huffmanFreeEncoder(model->encoder);
+    freeDecodeTable(&model->decodeTable);
+    free(model);
+
+}
+
+// huffmanAdaptiveChunkBound
+size_t huffmanAdaptiveChunkBound(int chunkLength, int maxCodeLength){
+
+    // Cantidad de caracteres, longitud del contenido y los bits de todos los códigos redondeados al byte
+    return ADAPTIVE_CHUNK_HEADER_LENGTH + ((size_t)chunkLength * maxCodeLength + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+}
+
+// huffmanEncodeAdaptiveChunk
+long long huffmanEncodeAdaptiveChunk(HuffmanAdaptiveModel_s *model, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    BitWriter_s bitWriter;
+    int sourcePosition = 0;
+    int runLength = 0;
+    int payloadLength = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(model == NULL || sourceLength < 0 || sourceLength > HUFFMAN_MAX_BLOCK_SIZE || (source == NULL && sourceLength > 0) || destination == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(capacity < huffmanAdaptiveChunkBound(sourceLength, model->encoder->maxCodeLength))
+        return HUFFMAN_ERROR_CAPACITY;
+
+    if(model->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Trozo: cantidad de caracteres, longitud del contenido y contenido (Un trozo sin caracteres marca el final del flujo)
+    storeUInt32(destination, sourceLength);
+    bitWriter.position = destination + ADAPTIVE_CHUNK_HEADER_LENGTH;
+    bitWriter.bitBuffer = 0;
+    bitWriter.bitsInBuffer = 0;
+
+    // Ciframos con los códigos actuales hasta la siguiente reconstrucción, contando cada byte después de cifrarlo
+    while(sourcePosition < sourceLength){
+
+        runLength = sourceLength - sourcePosition;
+
+        if(runLength > model->symbolsUntilRebuild)
+            runLength = model->symbolsUntilRebuild;
+
+        for(int i = sourcePosition; i < sourcePosition + runLength; i++){
+
+            writeCode(&bitWriter, model->encoder->huffmanCodes[source[i]]);
+            model->symbolCounts[source[i]]++;
+
+        }
+
+        sourcePosition += runLength;
+        model->totalCount += runLength;
+        model->symbolsUntilRebuild -= runLength;
+
+        if(model->symbolsUntilRebuild == 0){
+
+            if(model->stats != NULL)
+                huffmanMeasureStage(&stageClock, &model->stats->wallTimes.encode, &model->stats->cpuTimes.encode);
+
+            rebuildAdaptiveCodes(model);
+
+            if(model->stats != NULL)
+                huffmanMeasureStage(&stageClock, &model->stats->wallTimes.codeGeneration, &model->stats->cpuTimes.codeGeneration);
+
+        }
+
+    }
+
+    // Cada trozo termina en un byte completo para poder enviarlo en cuanto está cifrado
+    flushBitWriter(&bitWriter);
+    payloadLength = bitWriter.position - destination - ADAPTIVE_CHUNK_HEADER_LENGTH;
+    storeUInt32(destination + sizeof(unsigned int), payloadLength);
+
+    if(model->stats != NULL && sourceLength > 0){
+
+        huffmanMeasureStage(&stageClock, &model->stats->wallTimes.encode, &model->stats->cpuTimes.encode);
+
+        model->stats->blocksNumber++;
+        model->stats->symbolsNumber += sourceLength;
+        model->stats->payloadBits += (long long)payloadLength * BITS_IN_BYTE;
+
+        if(model->codesMaxLength > model->stats->maxCodeLength)
+            model->stats->maxCodeLength = model->codesMaxLength;
+
+    }
+
+    return bitWriter.position - destination;
+
+}
+
+// huffmanGetAdaptiveChunkLength
+long long huffmanGetAdaptiveChunkLength(const byte *source, size_t availableLength, int *charactersNumber){
+
+    // Variables necesarias
+    unsigned int chunkCharactersNumber = 0;
+    unsigned int payloadLength = 0;
+
+    // Igual que con los bloques, mientras no haya bytes suficientes devolvemos cuántos hacen falta
+    if(availableLength < ADAPTIVE_CHUNK_HEADER_LENGTH)
+        return ADAPTIVE_CHUNK_HEADER_LENGTH;
+
+    chunkCharactersNumber = loadUInt32(source);
+    payloadLength = loadUInt32(source + sizeof(unsigned int));
+
+    if(chunkCharactersNumber > HUFFMAN_MAX_BLOCK_SIZE || payloadLength > INT_MAX || (chunkCharactersNumber == 0 && payloadLength != 0))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if(charactersNumber != NULL)
+        *charactersNumber = chunkCharactersNumber;
+
+    return ADAPTIVE_CHUNK_HEADER_LENGTH + (long long)payloadLength;
+
+}
+
+// huffmanDecodeAdaptiveChunk
+long long huffmanDecodeAdaptiveChunk(HuffmanAdaptiveModel_s *model, const byte *frame, size_t frameLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    BitReader_s bitReader;
+    long long neededLength = 0;
+    int charactersNumber = 0;
+    int decodedLength = 0;
+    int runLength = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(model == NULL || frame == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(model->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // El trozo debe estar completo y caber en el destino
+    neededLength = huffmanGetAdaptiveChunkLength(frame, frameLength, &charactersNumber);
+
+    if(neededLength < 0)
+        return neededLength;
+
+    if((size_t)neededLength > frameLength)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if((size_t)charactersNumber > capacity || (destination == NULL && charactersNumber > 0))
+        return HUFFMAN_ERROR_CAPACITY;
+
+    initBitReader(&bitReader, frame + ADAPTIVE_CHUNK_HEADER_LENGTH, neededLength - ADAPTIVE_CHUNK_HEADER_LENGTH);
+
+    // Repetimos las mismas actualizaciones del modelo que hizo el cifrado, en los mismos puntos
+    while(decodedLength < charactersNumber){
+
+        // La tabla de descifrado solo se construye cuando hace falta tras cada reconstrucción de los códigos
+        if(!model->hasDecodeTable){
+
+            for(int i = 0; i < SYMBOLS_NUMBER; i++)
+                model->codeLengths[i] = model->encoder->huffmanCodes[i].codeLength;
+
+            buildTreeFromCodeLengths(model->codeLengths, &model->huffmanTree);
+
+            if(buildDecodeTable(&model->huffmanTree, &model->decodeTable) < 0)
+                return HUFFMAN_ERROR_CAPACITY;
+
+            model->hasDecodeTable = 1;
+
+            if(model->stats != NULL)
+                huffmanMeasureStage(&stageClock, &model->stats->wallTimes.decodeTable, &model->stats->cpuTimes.decodeTable);
+
+        }
+
+        runLength = charactersNumber - decodedLength;
+
+        if(runLength > model->symbolsUntilRebuild)
+            runLength = model->symbolsUntilRebuild;
+
+        for(int i = decodedLength; i < decodedLength + runLength; i++){
+
+            destination[i] = decodeSymbol(&bitReader, &model->decodeTable);
+            model->symbolCounts[destination[i]]++;
+
+        }
+
+        decodedLength += runLength;
+        model->totalCount += runLength;
+        model->symbolsUntilRebuild -= runLength;
+
+        if(model->symbolsUntilRebuild == 0){
+
+            if(model->stats != NULL)
+                huffmanMeasureStage(&stageClock, &model->stats->wallTimes.decode, &model->stats->cpuTimes.decode);
+
+            rebuildAdaptiveCodes(model);
+
+            if(model->stats != NULL)
+                huffmanMeasureStage(&stageClock, &model->stats->wallTimes.decodeTable, &model->stats->cpuTimes.decodeTable);
+
+        }
+
+    }
+
+    if(model->stats != NULL && charactersNumber > 0){
+
+        huffmanMeasureStage(&stageClock, &model->stats->wallTimes.decode, &model->stats->cpuTimes.decode);
+
+        model->stats->blocksNumber++;
+        model->stats->symbolsNumber += charactersNumber;
+        model->stats->payloadBits += (neededLength - ADAPTIVE_CHUNK_HEADER_LENGTH) * BITS_IN_BYTE;
+
+        if(model->codesMaxLength > model->stats->maxCodeLength)
+            model->stats->maxCodeLength = model->codesMaxLength;
+
+    }
+
+    return charactersNumber;
+
+}
+
+// huffmanBuildStaticTable
+int huffmanBuildStaticTable(const unsigned long long *symbolCounts, int maxCodeLength, byte *codeLengths){
+
+    // Variables necesarias
+    HuffmanEncoder_s *encoder = NULL;
+    unsigned long long totalCount = 0;
+    int shift = 0;
+    int huffmanCodesMaxLength = 0;
+
+    if(symbolCounts == NULL || codeLengths == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Las longitudes se calculan con las mismas funciones que en el cifrado por bloques, sobre un contexto de cifrado temporal
+    if((encoder = huffmanCreateEncoder(HUFFMAN_DEFAULT_BLOCK_SIZE, maxCodeLength, 1)) == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Reducimos las cuentas de las muestras hasta que su suma quepa en las frecuencias del árbol
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        totalCount += symbolCounts[i];
+
+    while((totalCount >> shift) > STATIC_TABLE_MAX_TOTAL_COUNT)
+        shift++;
+
+    // Sumamos 1 a cada byte para que todos tengan código aunque no aparezcan en las muestras
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        encoder->frequencyTable[i] = (symbolCounts[i] >> shift) + 1;
+
+    encoder->charactersNumber = sortCharactersByFrequency(encoder->frequencyTable, encoder->sortedCharacters);
+    buildTree(encoder->sortedCharacters, encoder->charactersNumber, &encoder->huffmanTree);
+    initHuffmanCodes(encoder->huffmanCodes);
+    huffmanCodesMaxLength = generateHuffmanCodes(encoder->huffmanCodes, &encoder->huffmanTree);
+
+    if(huffmanCodesMaxLength > encoder->maxCodeLength)
+        limitCodeLengths(encoder);
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        codeLengths[i] = encoder->huffmanCodes[i].codeLength;
+
+    huffmanFreeEncoder(encoder);
+
+    return 0;
+
+}
+
+// huffmanGetBuiltinStaticTable
+int huffmanGetBuiltinStaticTable(int tableId, byte *codeLengths){
+
+    if(tableId < 1 || tableId > HUFFMAN_BUILTIN_TABLES_NUMBER || codeLengths == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    memcpy(codeLengths, builtinStaticTables[tableId - 1], SYMBOLS_NUMBER);
+
+    return 0;
+
+}
+
+// huffmanWriteStaticTable
+int huffmanWriteStaticTable(byte *destination, int tableId, const byte *codeLengths){
+
+    if(destination == NULL || codeLengths == NULL || tableId < 1 || tableId > HUFFMAN_MAX_TABLE_ID)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Fichero de tabla: identificador, versión, número de la tabla y la longitud de código de cada byte
+    memcpy(destination, STATIC_TABLE_MAGIC, CONTAINER_MAGIC_LENGTH);
+    destination[CONTAINER_MAGIC_LENGTH] = STATIC_TABLE_VERSION;
+    destination[CONTAINER_MAGIC_LENGTH + 1] = tableId;
+    memcpy(destination + CONTAINER_MAGIC_LENGTH + 2, codeLengths, SYMBOLS_NUMBER);
+
+    return HUFFMAN_STATIC_TABLE_LENGTH;
+
+}
+
+// huffmanReadStaticTable
+long long huffmanReadStaticTable(const byte *source, size_t sourceLength, int *tableId, byte *codeLengths){
+
+    if(source == NULL || codeLengths == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(sourceLength < HUFFMAN_STATIC_TABLE_LENGTH)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if(memcmp(source, STATIC_TABLE_MAGIC, CONTAINER_MAGIC_LENGTH) != 0)
+        return HUFFMAN_ERROR_FORMAT;
+
+    if(source[CONTAINER_MAGIC_LENGTH] != STATIC_TABLE_VERSION)
+        return HUFFMAN_ERROR_VERSION;
+
+    if(source[CONTAINER_MAGIC_LENGTH + 1] == 0)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Las longitudes se comprueban al cargar la tabla en un contexto
+    memcpy(codeLengths, source + CONTAINER_MAGIC_LENGTH + 2, SYMBOLS_NUMBER);
+
+    if(tableId != NULL)
+        *tableId = source[CONTAINER_MAGIC_LENGTH + 1];
+
+    return HUFFMAN_STATIC_TABLE_LENGTH;
+
+}
+
+// huffmanSetEncoderStaticTable
+int huffmanSetEncoderStaticTable(HuffmanEncoder_s *encoder, int tableId, const byte *codeLengths){
+
+    // Variables necesarias
+    byte builtinCodeLengths[SYMBOLS_NUMBER];
+    int treeCodeLengths[SYMBOLS_NUMBER];
+    int codesMaxLength = 0;
+
+    if(encoder == NULL || tableId < 0 || tableId > HUFFMAN_MAX_TABLE_ID)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Con el identificador 0 el contexto vuelve a calcular una tabla para cada bloque
+    if(tableId == 0){
+
+        encoder->staticTableId = 0;
+        return 0;
+
+    }
+
+    // Sin longitudes usamos la tabla de la biblioteca con ese identificador
+    if(codeLengths == NULL){
+
+        if(huffmanGetBuiltinStaticTable(tableId, builtinCodeLengths) < 0)
+            return HUFFMAN_ERROR_ARGUMENT;
+
+        codeLengths = builtinCodeLengths;
+
+    }
+
+    // Calculamos los códigos canónicos una única vez, todos los bloques siguientes los reutilizan
+    if((codesMaxLength = buildStaticTableTree(codeLengths, encoder->maxCodeLength, treeCodeLengths, &encoder->huffmanTree)) < 0)
+        return codesMaxLength;
+
+    initHuffmanCodes(encoder->staticCodes);
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        encoder->staticCodes[i].codeLength = treeCodeLengths[i];
+
+    assignCanonicalCodes(encoder->staticCodes, codesMaxLength);
+    encoder->staticCodesMaxLength = codesMaxLength;
+    encoder->staticTableId = tableId;
+
+    return 0;
+
+}
+
+// huffmanAddDecoderStaticTable
+int huffmanAddDecoderStaticTable(HuffmanDecoder_s *decoder, int tableId, const byte *codeLengths){
+
+    // Variables necesarias
+    byte builtinCodeLengths[SYMBOLS_NUMBER];
+    int codesMaxLength = 0;
+
+    if(decoder == NULL || tableId < 1 || tableId > HUFFMAN_MAX_TABLE_ID)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(codeLengths == NULL){
+
+        if(huffmanGetBuiltinStaticTable(tableId, builtinCodeLengths) < 0)
+            return HUFFMAN_ERROR_ARGUMENT;
+
+        codeLengths = builtinCodeLengths;
+
+    }
+
+    if((codesMaxLength = buildStaticTableTree(codeLengths, MAX_CODE_LENGTH, decoder->codeLengths, &decoder->huffmanTree)) < 0)
+        return codesMaxLength;
+
+    // La tabla de descifrado se construye aquí una única vez y los bloques que usan la tabla solo la consultan
+    if(decoder->staticTables[tableId] == NULL){
+
+        if((decoder->staticTables[tableId] = (StaticTable_s*)calloc(1, sizeof(StaticTable_s))) == NULL)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        if(decoder->stats != NULL)
+            decoder->stats->allocationsNumber++;
+
+    }
+
+    // Una tabla a medias no se puede quedar registrada, los bloques que la usen fallarían al descifrar
+    if(buildDecodeTable(&decoder->huffmanTree, &decoder->staticTables[tableId]->decodeTable) < 0){
+
+        freeDecodeTable(&decoder->staticTables[tableId]->decodeTable);
+        free(decoder->staticTables[tableId]);
+        decoder->staticTables[tableId] = NULL;
+
+        return HUFFMAN_ERROR_CAPACITY;
+
+    }
+
+    decoder->staticTables[tableId]->codesMaxLength = codesMaxLength;
+
+    return 0;
+
+}
+
+// huffmanErrorMessage
+const char* huffmanErrorMessage(long long errorCode){
+
+    switch(errorCode){
+
+        case HUFFMAN_ERROR_CAPACITY:
+            return "El buffer de destino no tiene capacidad suficiente.";
+        case HUFFMAN_ERROR_INCOMPLETE:
+            return "El fichero cifrado está incompleto.";
+        case HUFFMAN_ERROR_CORRUPT:
+            return "El contenido cifrado no es válido.";
+        case HUFFMAN_ERROR_FORMAT:
+            return "El fichero no es un fichero cifrado.";
+        case HUFFMAN_ERROR_VERSION:
+            return "La versión del fichero cifrado no está soportada.";
+        case HUFFMAN_ERROR_ARGUMENT:
+            return "Los parámetros no son válidos.";
+        case HUFFMAN_ERROR_TABLE:
+            return "El fichero cifrado usa una tabla estática que no se ha cargado.";
+        default:
+            return "Error desconocido.";
+
+    }
+
+}
+
+// huffmanSetEncoderStats
+void huffmanSetEncoderStats(HuffmanEncoder_s *encoder, HuffmanStats_s *stats){
+
+    // El contexto suma en la estructura indicada las estadísticas de los bloques que cifre a partir de ahora
+    if(encoder != NULL)
+        encoder->stats = stats;
+
+}
+
+// huffmanSetDecoderStats
+void huffmanSetDecoderStats(HuffmanDecoder_s *decoder, HuffmanStats_s *stats){
+
+    if(decoder != NULL)
+        decoder->stats = stats;
+
+}
+
+// huffmanSetAdaptiveStats
+void huffmanSetAdaptiveStats(HuffmanAdaptiveModel_s *model, HuffmanStats_s *stats){
+
+    if(model != NULL)
+        model->stats = stats;
+
+}
+
+// huffmanAddStats
+void huffmanAddStats(HuffmanStats_s *total, const HuffmanStats_s *partial){
+
+    // Juntamos las estadísticas de varios contextos (Por ejemplo uno por hilo)
+    addStageTimes(&total->wallTimes, &partial->wallTimes);
+    addStageTimes(&total->cpuTimes, &partial->cpuTimes);
+
+    total->blocksNumber += partial->blocksNumber;
+    total->symbolsNumber += partial->symbolsNumber;
+    total->payloadBits += partial->payloadBits;
+    total->allocationsNumber += partial->allocationsNumber;
+    total->bytesIn += partial->bytesIn;
+    total->bytesOut += partial->bytesOut;
+
+    if(partial->maxCodeLength > total->maxCodeLength)
+        total->maxCodeLength = partial->maxCodeLength;
+
+    if(partial->maxDistinctSymbols > total->maxDistinctSymbols)
+        total->maxDistinctSymbols = partial->maxDistinctSymbols;
+
+}
+
+// huffmanMeasureStage
+void huffmanMeasureStage(HuffmanStageClock_s *stageClock, double *wallTime, double *cpuTime){
+
+    // Variables necesarias
+    struct timespec now;
+    double currentWallTime = 0;
+    double currentCpuTime = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    currentWallTime = now.tv_sec + now.tv_nsec / 1e9;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    currentCpuTime = now.tv_sec + now.tv_nsec / 1e9;
+
+    // Sumamos a la etapa lo transcurrido desde su inicio y empezamos la siguiente
+    if(wallTime != NULL)
+        *wallTime += currentWallTime - stageClock->wallTime;
+
+    if(cpuTime != NULL)
+        *cpuTime += currentCpuTime - stageClock->cpuTime;
+
+    stageClock->wallTime = currentWallTime;
+    stageClock->cpuTime = currentCpuTime;
+
+}
+
+// countFrequencies
+static void countFrequencies(const byte *content, size_t length, unsigned int *frequencyTable){
+
+    // Variables necesarias
+    unsigned int frequencyTables[HISTOGRAM_TABLES_NUMBER][SYMBOLS_NUMBER];
+    size_t i = 0;
+
+    // Repartimos los bytes consecutivos entre varias tablas, así dos bytes iguales seguidos no esperan
+    // uno a que termine la suma del otro sobre la misma posición de memoria
+    memset(frequencyTables, 0, sizeof(frequencyTables));
+
+    for(i = 0; i + HISTOGRAM_TABLES_NUMBER <= length; i += HISTOGRAM_TABLES_NUMBER){
+
+        frequencyTables[0][content[i]]++;
+        frequencyTables[1][content[i + 1]]++;
+        frequencyTables[2][content[i + 2]]++;
+        frequencyTables[3][content[i + 3]]++;
+
+    }
+
+    for(; i < length; i++)
+        frequencyTables[0][content[i]]++;
+
+    // Juntamos las tablas parciales
+    for(int j = 0; j < SYMBOLS_NUMBER; j++)
+        frequencyTable[j] = frequencyTables[0][j] + frequencyTables[1][j] + frequencyTables[2][j] + frequencyTables[3][j];
+
+}
+
+// countContextFrequencies
+static void countContextFrequencies(const byte *content, size_t length, unsigned int *contextFrequencyTables, unsigned int *frequencyTable){
+
+    // Variables necesarias
+    byte previous = 0;
+
+    // Cada byte cuenta en la tabla del byte anterior (El primero del bloque cuenta como si le precediera un 0)
+    memset(contextFrequencyTables, 0, (size_t)SYMBOLS_NUMBER * SYMBOLS_NUMBER * sizeof(unsigned int));
+
+    for(size_t i = 0; i < length; i++){
+
+        contextFrequencyTables[previous * SYMBOLS_NUMBER + content[i]]++;
+        previous = content[i];
+
+    }
+
+    // El histograma del bloque es la suma de las tablas de todos los contextos
+    memset(frequencyTable, 0, SYMBOLS_NUMBER * sizeof(unsigned int));
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            frequencyTable[j] += contextFrequencyTables[i * SYMBOLS_NUMBER + j];
+
+}
+
+// countFrequenciesInParallel
+static void countFrequenciesInParallel(HuffmanEncoder_s *encoder, const byte *content, size_t length){
+
+    // Variables necesarias
+    HistogramPart_s *histogramParts = encoder->histogramParts;
+    size_t partLength = 0;
+
+    // Dividimos el contenido en partes iguales, el hilo actual cuenta la primera
+    partLength = length / encoder->threadsNumber;
+
+    for(int i = 0; i < encoder->threadsNumber; i++){
+
+        histogramParts[i].content = content + i * partLength;
+        histogramParts[i].length = (i == encoder->threadsNumber - 1) ? length - i * partLength : partLength;
+
+    }
+
+    // Si no se puede crear algún hilo su parte la cuenta el hilo actual
+    for(int i = 1; i < encoder->threadsNumber; i++)
+        histogramParts[i].isThreaded = (pthread_create(&encoder->histogramThreads[i], NULL, histogramWorker, &histogramParts[i]) == 0);
+
+    histogramWorker(&histogramParts[0]);
+
+    // Sumamos las tablas parciales a medida que terminan los hilos
+    memcpy(encoder->frequencyTable, histogramParts[0].frequencyTable, SYMBOLS_NUMBER * sizeof(unsigned int));
+
+    for(int i = 1; i < encoder->threadsNumber; i++){
+
+        if(histogramParts[i].isThreaded)
+            pthread_join(encoder->histogramThreads[i], NULL);
+        else
+            histogramWorker(&histogramParts[i]);
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            encoder->frequencyTable[j] += histogramParts[i].frequencyTable[j];
+
+    }
+
+}
+
+
+// histogramWorker
+static void* histogramWorker(void *arg){
+
+    // Variables necesarias
+    HistogramPart_s *histogramPart = (HistogramPart_s*)arg;
+
+    countFrequencies(histogramPart->content, histogramPart->length, histogramPart->frequencyTable);
+
+    return NULL;
+
+}
+
+// sortCharactersByFrequency
+static int sortCharactersByFrequency(unsigned int *frequencyTable, StringCharacter_s *sortedCharacters){
+
+    // Variables necesarias
+    int charactersNumber = 0;
+
+    // Tomamos los bytes que aparecen al menos una vez
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        if(frequencyTable[i] > 0){
+
+            sortedCharacters[charactersNumber].character = i;
+            sortedCharacters[charactersNumber].frequency = frequencyTable[i];
+            charactersNumber++;
+
+        }
+
+    }
+
+    // Un bloque vacío se cifra como si tuviera un único byte sin apariciones
+    if(charactersNumber == 0){
+
+        sortedCharacters[0].character = '\0';
+        sortedCharacters[0].frequency = 0;
+        charactersNumber = 1;
+
+    }
+
+    // Los ordenamos de menor a mayor frecuencia (A igual frecuencia por el valor del byte)
+    qsort(sortedCharacters, charactersNumber, sizeof(StringCharacter_s), compareCharacters);
+
+    return charactersNumber;
+
+}
+
+// compareCharacters
+static int compareCharacters(const void *firstCharacter, const void *secondCharacter){
+
+    // Variables necesarias
+    const StringCharacter_s *first = (const StringCharacter_s*)firstCharacter;
+    const StringCharacter_s *second = (const StringCharacter_s*)secondCharacter;
+
+    if(first->frequency != second->frequency)
+        return (first->frequency < second->frequency) ? -1 : 1;
+
+    return first->character - second->character;
+
+}
+
+// buildTree
+static void buildTree(StringCharacter_s *sortedCharacters, int charactersNumber, HuffmanTree_s *huffmanTree){
+
+    // Variables necesarias
+    TreeNode_s *mergedNodes = huffmanTree->mergedNodes;
+    TreeNode_s *nodes = huffmanTree->nodes;
+    int children[2];
+    int nodesNumber = 0;
+    int nextLeaf = 0;
+    int nextBranch = 0;
+
+    // Las hojas ocupan el inicio del array de mezcla en el mismo orden que los caracteres
+    for(int i = 0; i < charactersNumber; i++){
+
+        mergedNodes[i].stringCharacter = sortedCharacters[i];
+        mergedNodes[i].leftChild = TREE_NO_CHILD;
+        mergedNodes[i].rightChild = TREE_NO_CHILD;
+
+    }
+
+    // Las ramas se van añadiendo detrás y, como cada una pesa al menos lo que la anterior, ya salen ordenadas
+    // Así tenemos dos colas ordenadas (Hojas y ramas) y los dos nodos mínimos siempre están al principio de alguna
+    nodesNumber = charactersNumber;
+    nextBranch = charactersNumber;
+
+    while(nodesNumber - nextLeaf - (nextBranch - charactersNumber) > 1){
+
+        // Extraemos los dos nodos mínimos (A igual frecuencia preferimos la hoja)
+        for(int i = 0; i < 2; i++){
+
+            if(nextLeaf < charactersNumber && (nextBranch == nodesNumber || mergedNodes[nextLeaf].stringCharacter.frequency <= mergedNodes[nextBranch].stringCharacter.frequency))
+                children[i] = nextLeaf++;
+            else
+                children[i] = nextBranch++;
+
+        }
+
+        // Creamos el nodo padre de ambos al final del array, con la suma de sus frecuencias
+        mergedNodes[nodesNumber].stringCharacter.character = '\0';
+        mergedNodes[nodesNumber].stringCharacter.frequency = mergedNodes[children[0]].stringCharacter.frequency + mergedNodes[children[1]].stringCharacter.frequency;
+        mergedNodes[nodesNumber].leftChild = children[0];
+        mergedNodes[nodesNumber].rightChild = children[1];
+        nodesNumber++;
+
+    }
+
+    // Copiamos el árbol por niveles empezando por la raíz (El último nodo creado), usando el propio array de destino como cola
+    // Cada nodo pasa a apuntar a la posición de sus hijos en el nuevo array, la 0 es la raíz y por eso indica que no hay hijo
+    nodes[0] = mergedNodes[nodesNumber - 1];
+    huffmanTree->nodesNumber = 1;
+
+    for(int i = 0; i < huffmanTree->nodesNumber; i++){
+
+        if(nodes[i].leftChild == TREE_NO_CHILD && nodes[i].rightChild == TREE_NO_CHILD)
+            continue;
+
+        nodes[huffmanTree->nodesNumber] = mergedNodes[nodes[i].leftChild];
+        nodes[huffmanTree->nodesNumber + 1] = mergedNodes[nodes[i].rightChild];
+        nodes[i].leftChild = huffmanTree->nodesNumber;
+        nodes[i].rightChild = huffmanTree->nodesNumber + 1;
+        huffmanTree->nodesNumber += 2;
+
+    }
+
+}
+
+// buildTreeFromCodeLengths
+static int buildTreeFromCodeLengths(int *codeLengths, HuffmanTree_s *huffmanTree){
+
+    // Variables necesarias
+    TreeNode_s *nodes = huffmanTree->nodes;
+    int lengthCount[MAX_CODE_LENGTH + 1] = {0};
+    int maxCodeLength = 0;
+    int symbolsCount = 0;
+    int levelStart = 0;
+    int levelNodes = 1;
+    int levelBranches = 0;
+    int nextNode = 0;
+
+    // Contamos cuántos códigos hay de cada longitud
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        if(codeLengths[i] > 0){
+
+            lengthCount[codeLengths[i]]++;
+            symbolsCount++;
+
+            if(codeLengths[i] > maxCodeLength)
+                maxCodeLength = codeLengths[i];
+
+        }
+
+    }
+
+    if(symbolsCount == 0)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Construimos el árbol por niveles directamente en el array, la raíz en la posición 0
+    // En un código canónico las hojas de cada nivel son los nodos más a la izquierda y van en orden de byte,
+    // así que en cada nivel primero van sus hojas y después las ramas, cuyos hijos forman el nivel siguiente
+    nodes[0].stringCharacter.character = '\0';
+    nodes[0].leftChild = TREE_NO_CHILD;
+    nodes[0].rightChild = TREE_NO_CHILD;
+    huffmanTree->nodesNumber = 1;
+
+    for(int depth = 1; depth <= maxCodeLength; depth++){
+
+        // Las ramas del nivel anterior son los nodos que no son hojas, cada una tiene dos hijos en este nivel
+        levelBranches = levelNodes - lengthCount[depth - 1];
+
+        if(levelBranches < 0)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        for(int i = 0; i < levelBranches; i++){
+
+            nodes[levelStart + lengthCount[depth - 1] + i].leftChild = huffmanTree->nodesNumber + 2 * i;
+            nodes[levelStart + lengthCount[depth - 1] + i].rightChild = huffmanTree->nodesNumber + 2 * i + 1;
+
+        }
+
+        levelStart = huffmanTree->nodesNumber;
+        levelNodes = 2 * levelBranches;
+
+        if(levelNodes < lengthCount[depth] || levelStart + levelNodes > TREE_NODES_NUMBER)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        for(int i = 0; i < levelNodes; i++){
+
+            nodes[levelStart + i].stringCharacter.character = '\0';
+            nodes[levelStart + i].leftChild = TREE_NO_CHILD;
+            nodes[levelStart + i].rightChild = TREE_NO_CHILD;
+
+        }
+
+        // Colocamos las hojas de este nivel en orden de byte
+        nextNode = levelStart;
+
+        for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+            if(codeLengths[i] == depth)
+                nodes[nextNode++].stringCharacter.character = i;
+
+        }
+
+        huffmanTree->nodesNumber += levelNodes;
+
+    }
+
+    // En el último nivel todos los nodos deben ser hojas para que el código sea completo
+    // Si solo hay un símbolo la otra hoja de la raíz repite el mismo byte para que cualquier bit lo descifre
+    if(symbolsCount == 1 && maxCodeLength == 1)
+        nodes[levelStart + 1].stringCharacter.character = nodes[levelStart].stringCharacter.character;
+    else if(levelNodes != lengthCount[maxCodeLength])
+        return HUFFMAN_ERROR_CORRUPT;
+
+    return 0;
+
+}
+
+// getTreeDepth
+static int getTreeDepth(HuffmanTree_s *huffmanTree, int node){
+
+    // Variables necesarias
+    int leftDepth = 0;
+    int rightDepth = 0;
+
+    // Caso base (El nodo es una hoja)
+    if(huffmanTree->nodes[node].leftChild == TREE_NO_CHILD)
+        return 0;
+
+    // Si es una rama / raíz la profundidad es la de su hijo más profundo más uno
+    leftDepth = getTreeDepth(huffmanTree, huffmanTree->nodes[node].leftChild);
+    rightDepth = getTreeDepth(huffmanTree, huffmanTree->nodes[node].rightChild);
+
+    return (leftDepth > rightDepth ? leftDepth : rightDepth) + 1;
+
+}
+
+// initHuffmanCodes
+static void initHuffmanCodes(HuffmanCode_s *huffmanCodes){
+
+    // Inicializamos los códigos de huffman (La posición de cada código es el propio valor del byte)
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        huffmanCodes[i].character = i;
+        huffmanCodes[i].code = 0;
+        huffmanCodes[i].codeLength = 0;
+
+    }
+
+}
+
+// generateHuffmanCodes
+static int generateHuffmanCodes(HuffmanCode_s *huffmanCodes, HuffmanTree_s *huffmanTree){
+
+    // Variables necesarias
+    unsigned char depths[TREE_NODES_NUMBER];
+    TreeNode_s *node = NULL;
+    int maxDepth = 0;
+
+    // Al estar el árbol por niveles cada padre va antes que sus hijos, así que basta una pasada para conocer la profundidad de todos
+    depths[0] = 0;
+
+    for(int i = 0; i < huffmanTree->nodesNumber; i++){
+
+        node = &huffmanTree->nodes[i];
+
+        // Si es una hoja la longitud del código es su profundidad (Si el árbol es una única hoja usamos un bit)
+        if(node->leftChild == TREE_NO_CHILD && node->rightChild == TREE_NO_CHILD){
+
+            huffmanCodes[node->stringCharacter.character].codeLength = (depths[i] > 0) ? depths[i] : 1;
+
+            if(huffmanCodes[node->stringCharacter.character].codeLength > maxDepth)
+                maxDepth = huffmanCodes[node->stringCharacter.character].codeLength;
+
+        }
+        // Si es una rama sus hijos están un nivel más abajo
+        else{
+
+            depths[node->leftChild] = depths[i] + 1;
+            depths[node->rightChild] = depths[i] + 1;
+
+        }
+
+    }
+
+    return maxDepth;
+
+}
+
+// assignCanonicalCodes
+static void assignCanonicalCodes(HuffmanCode_s *huffmanCodes, int maxCodeLength){
+
+    // Variables necesarias
+    int lengthCount[HUFFMAN_MAX_CODE_LENGTH_LIMIT + 1] = {0};
+    unsigned long long nextCode[HUFFMAN_MAX_CODE_LENGTH_LIMIT + 1] = {0};
+    unsigned long long code = 0;
+
+    // Contamos cuántos códigos hay de cada longitud
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        lengthCount[huffmanCodes[i].codeLength]++;
+
+    // Calculamos el primer código de cada longitud (Los códigos de una longitud siguen a los de la anterior)
+    lengthCount[0] = 0;
+
+    for(int i = 1; i <= maxCodeLength; i++){
+
+        code = (code + lengthCount[i - 1]) << 1;
+        nextCode[i] = code;
+
+    }
+
+    // Asignamos los códigos en orden de byte dentro de cada longitud (Valor entero alineado a la derecha)
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        if(huffmanCodes[i].codeLength > 0)
+            huffmanCodes[i].code = nextCode[huffmanCodes[i].codeLength]++;
+
+}
+
+// limitCodeLengths
+static int limitCodeLengths(HuffmanEncoder_s *encoder){
+
+    // Variables necesarias
+    StringCharacter_s *leaves = encoder->sortedCharacters;
+    int leavesNumber = encoder->charactersNumber;
+    int maxCodeLength = encoder->maxCodeLength;
+    HuffmanCode_s *huffmanCodes = encoder->huffmanCodes;
+    PackageItem_s *levels[HUFFMAN_MAX_CODE_LENGTH_LIMIT];
+    int levelsLength[HUFFMAN_MAX_CODE_LENGTH_LIMIT] = {0};
+    int leafPosition = 0;
+    int packagePosition = 0;
+    int selectedItems = 0;
+    int selectedPackages = 0;
+    int resultMaxLength = 0;
+
+    // Los niveles se guardan en el contexto, que los reserva la primera vez que hace falta limitar
+    if(encoder->packageItems == NULL)
+        encoder->packageItems = (PackageItem_s*)malloc((size_t)HUFFMAN_MAX_CODE_LENGTH_LIMIT * 2 * SYMBOLS_NUMBER * sizeof(PackageItem_s));
+
+    // Las hojas son los caracteres, que ya están ordenados por frecuencia ascendente
+    // Algoritmo package-merge: cada nivel mezcla las hojas con los paquetes (parejas) del nivel anterior
+    for(int level = 0; level < maxCodeLength; level++){
+
+        levels[level] = encoder->packageItems + (size_t)level * 2 * SYMBOLS_NUMBER;
+        leafPosition = 0;
+        packagePosition = 0;
+
+        // En el primer nivel solo hay hojas, en el resto mezclamos ordenadamente hojas y paquetes
+        while(leafPosition < leavesNumber || (level > 0 && packagePosition + 1 < levelsLength[level - 1])){
+
+            // Variables necesarias
+            unsigned long long packageWeight = 0;
+
+            if(level > 0 && packagePosition + 1 < levelsLength[level - 1])
+                packageWeight = levels[level - 1][packagePosition].weight + levels[level - 1][packagePosition + 1].weight;
+
+            // Si queda alguna hoja y pesa lo mismo o menos que el siguiente paquete la insertamos
+            if(leafPosition < leavesNumber && (level == 0 || packagePosition + 1 >= levelsLength[level - 1] || (unsigned long long)leaves[leafPosition].frequency <= packageWeight)){
+
+                levels[level][levelsLength[level]].weight = leaves[leafPosition].frequency;
+                levels[level][levelsLength[level]].isPackage = 0;
+                levels[level][levelsLength[level]].leafIndex = leafPosition;
+                leafPosition++;
+
+            }
+            // Si no insertamos el paquete
+            else{
+
+                levels[level][levelsLength[level]].weight = packageWeight;
+                levels[level][levelsLength[level]].isPackage = 1;
+                levels[level][levelsLength[level]].leafIndex = -1;
+                packagePosition += 2;
+
+            }
+
+            levelsLength[level]++;
+
+        }
+
+    }
+
+    // Reiniciamos las longitudes de los códigos
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        huffmanCodes[i].codeLength = 0;
+
+    // Seleccionamos los 2n - 2 primeros elementos del último nivel y bajamos por los paquetes elegidos
+    // Cada vez que una hoja aparece entre los elementos seleccionados su código crece un bit
+    selectedItems = 2 * leavesNumber - 2;
+
+    for(int level = maxCodeLength - 1; level >= 0 && selectedItems > 0; level--){
+
+        selectedPackages = 0;
+
+        for(int i = 0; i < selectedItems; i++){
+
+            if(levels[level][i].isPackage)
+                selectedPackages++;
+            else
+                huffmanCodes[leaves[levels[level][i].leafIndex].character].codeLength++;
+
+        }
+
+        selectedItems = 2 * selectedPackages;
+
+    }
+
+    // Obtenemos la nueva longitud máxima
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        if(huffmanCodes[i].codeLength > resultMaxLength)
+            resultMaxLength = huffmanCodes[i].codeLength;
+
+    return resultMaxLength;
+
+}
+
+// buildCodesFromFrequencies
+static int buildCodesFromFrequencies(HuffmanEncoder_s *encoder, const unsigned int *frequencyTable, HuffmanCode_s *huffmanCodes){
+
+    // Variables necesarias
+    int huffmanCodesMaxLength = 0;
+
+    // Seguimos los mismos pasos que un bloque normal sobre las tablas del contexto, así que los códigos del bloque se pierden
+    memcpy(encoder->frequencyTable, frequencyTable, sizeof(encoder->frequencyTable));
+    encoder->charactersNumber = sortCharactersByFrequency(encoder->frequencyTable, encoder->sortedCharacters);
+    buildTree(encoder->sortedCharacters, encoder->charactersNumber, &encoder->huffmanTree);
+
+    initHuffmanCodes(encoder->huffmanCodes);
+    huffmanCodesMaxLength = generateHuffmanCodes(encoder->huffmanCodes, &encoder->huffmanTree);
+
+    if(huffmanCodesMaxLength > encoder->maxCodeLength){
+
+        if(encoder->stats != NULL && encoder->packageItems == NULL)
+            encoder->stats->allocationsNumber++;
+
+        huffmanCodesMaxLength = limitCodeLengths(encoder);
+
+    }
+
+    assignCanonicalCodes(encoder->huffmanCodes, huffmanCodesMaxLength);
+    memcpy(huffmanCodes, encoder->huffmanCodes, SYMBOLS_NUMBER * sizeof(HuffmanCode_s));
+
+    return huffmanCodesMaxLength;
+
+}
+
+// packCodeLengths
+static int packCodeLengths(HuffmanCode_s *huffmanCodes, byte *buffer){
+
+    // Variables necesarias
+    int firstSymbol = 0;
+    int lastSymbol = 0;
+    int lengthBits = 1;
+    int maxCodeLength = 0;
+    int bitCounter = 0;
+    int bytesLength = 0;
+
+    // Buscamos el rango de bytes con código y la mayor longitud
+    firstSymbol = SYMBOLS_NUMBER - 1;
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        if(huffmanCodes[i].codeLength > 0){
+
+            if(i < firstSymbol)
+                firstSymbol = i;
+
+            lastSymbol = i;
+
+            if(huffmanCodes[i].codeLength > maxCodeLength)
+                maxCodeLength = huffmanCodes[i].codeLength;
+
+        }
+
+    }
+
+    // Si no hay ningún símbolo guardamos un rango de un único byte con longitud 0
+    if(firstSymbol > lastSymbol)
+        firstSymbol = lastSymbol;
+
+    // Calculamos los bits necesarios para representar la mayor longitud
+    while((1 << lengthBits) <= maxCodeLength)
+        lengthBits++;
+
+    // Sin buffer solo calculamos lo que ocupa la cabecera
+    if(buffer == NULL)
+        return CODE_LENGTHS_HEADER_START + ((lastSymbol - firstSymbol + 1) * lengthBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    // Cabecera: primer símbolo y último símbolo (16 bits, little endian) y bits por longitud
+    buffer[0] = firstSymbol;
+    buffer[1] = firstSymbol >> 8;
+    buffer[2] = lastSymbol;
+    buffer[3] = lastSymbol >> 8;
+    buffer[4] = lengthBits;
+    bytesLength = CODE_LENGTHS_HEADER_START;
+
+    // Empaquetamos las longitudes del rango de más significativo a menos significativo
+    memset(buffer + bytesLength, 0, ((lastSymbol - firstSymbol + 1) * lengthBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+
+    for(int i = firstSymbol; i <= lastSymbol; i++){
+
+        for(int j = lengthBits - 1; j >= 0; j--){
+
+            if((huffmanCodes[i].codeLength >> j) & 0b1)
+                buffer[bytesLength + bitCounter / BITS_IN_BYTE] |= 0x80 >> (bitCounter % BITS_IN_BYTE);
+
+            bitCounter++;
+
+        }
+
+    }
+
+    bytesLength += (bitCounter + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    return bytesLength;
+
+}
+
+// encodeStaticBlock
+static long long encodeStaticBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    size_t encodedBlockLength = 0;
+    int streamsNumber = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Sin histograma no sabemos lo que ocupará el contenido, así que comprobamos el peor caso con el código más largo de la tabla
+    streamsNumber = (sourceLength >= encoder->streamsNumber * STREAM_MIN_LENGTH) ? encoder->streamsNumber : 1;
+    encodedBlockLength = 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + ((size_t)sourceLength * encoder->staticCodesMaxLength + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    if(streamsNumber > 1)
+        encodedBlockLength += 1 + (streamsNumber - 1) * sizeof(unsigned int) + streamsNumber - 1;
+
+    if(encodedBlockLength > capacity)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    encodedBlockLength = encodeBlock(source, sourceLength, encoder->staticCodes, encoder->staticTableId, streamsNumber, destination);
+
+    // Anotamos los contadores del bloque (Los bits del contenido incluyen el relleno y la tabla de saltos)
+    if(encoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.encode, &encoder->stats->cpuTimes.encode);
+
+        encoder->stats->blocksNumber++;
+        encoder->stats->symbolsNumber += sourceLength;
+        encoder->stats->payloadBits += (encodedBlockLength - 2 * sizeof(unsigned int) - CODE_LENGTHS_HEADER_START) * BITS_IN_BYTE;
+
+        if(encoder->staticCodesMaxLength > encoder->stats->maxCodeLength)
+            encoder->stats->maxCodeLength = encoder->staticCodesMaxLength;
+
+    }
+
+    return encodedBlockLength;
+
+}
+
+// encodeBlock
+static int encodeBlock(const byte *blockContent, int blockLength, HuffmanCode_s *huffmanCodes, int staticTableId, int streamsNumber, byte *encodedBlock){
+
+    // Variables necesarias
+    byte *encodedBlockCopy = NULL;
+    byte *payloadLengthPosition = NULL;
+    byte *jumpTable = NULL;
+    int headerLength = 0;
+    int payloadLength = 0;
+    int segmentLength = 0;
+    int streamStart = 0;
+    int streamLength = 0;
+
+    // Realizamos una copia del puntero del bloque codificado
+    encodedBlockCopy = encodedBlock;
+
+    // Introducimos la cantidad de caracteres del bloque, marcando si va en varios flujos
+    storeUInt32(encodedBlockCopy, (streamsNumber > 1) ? (blockLength | MULTI_STREAM_FLAG) : (unsigned int)blockLength);
+    encodedBlockCopy += sizeof(unsigned int);
+
+    // Introducimos la cabecera con las longitudes de los códigos canónicos
+    // Con una tabla estática la cabecera solo lleva su identificador en el primer byte y 0 bits por longitud
+    if(staticTableId != 0){
+
+        memset(encodedBlockCopy, 0, CODE_LENGTHS_HEADER_START);
+        encodedBlockCopy[0] = staticTableId;
+        headerLength = CODE_LENGTHS_HEADER_START;
+
+    }
+    else
+        headerLength = packCodeLengths(huffmanCodes, encodedBlockCopy);
+
+    encodedBlockCopy += headerLength;
+
+    // Reservamos el hueco de la longitud del contenido codificado, que conocemos al terminar
+    payloadLengthPosition = encodedBlockCopy;
+    encodedBlockCopy += sizeof(unsigned int);
+
+    // Con un único flujo el contenido son directamente los códigos del bloque
+    if(streamsNumber == 1)
+        encodedBlockCopy += encodeStream(blockContent, blockLength, huffmanCodes, encodedBlockCopy);
+    // Con varios flujos el bloque se parte en tramos consecutivos del mismo tamaño (El último puede ser menor) y cada uno se codifica por separado
+    // Delante van el número de flujos y la tabla de saltos con la longitud de todos los flujos menos el último
+    else{
+
+        *encodedBlockCopy = streamsNumber;
+        jumpTable = encodedBlockCopy + 1;
+        encodedBlockCopy = jumpTable + (streamsNumber - 1) * sizeof(unsigned int);
+        segmentLength = (blockLength + streamsNumber - 1) / streamsNumber;
+
+        for(int i = 0; i < streamsNumber; i++){
+
+            streamLength = encodeStream(blockContent + streamStart, (i < streamsNumber - 1) ? segmentLength : blockLength - streamStart, huffmanCodes, encodedBlockCopy);
+            encodedBlockCopy += streamLength;
+            streamStart += segmentLength;
+
+            if(i < streamsNumber - 1)
+                storeUInt32(jumpTable + i * sizeof(unsigned int), streamLength);
+
+        }
+
+    }
+
+    // Completamos la longitud del contenido codificado
+    payloadLength = encodedBlockCopy - payloadLengthPosition - sizeof(unsigned int);
+    storeUInt32(payloadLengthPosition, payloadLength);
+
+    return encodedBlockCopy - encodedBlock;
+
+}
+
+// encodeStream
+static int encodeStream(const byte *streamContent, int streamLength, HuffmanCode_s *huffmanCodes, byte *encodedStream){
+
+    // Variables necesarias
+    BitWriter_s bitWriter = {encodedStream, 0, 0};
+
+    // Codificamos el flujo añadiendo cada código entero al buffer de bits y terminamos rellenando con 0 el último byte
+    for(int i = 0; i < streamLength; i++)
+        writeCode(&bitWriter, huffmanCodes[streamContent[i]]);
+
+    flushBitWriter(&bitWriter);
+
+    return bitWriter.position - encodedStream;
+
+}
+
+// writeCode
+static inline void writeCode(BitWriter_s *bitWriter, HuffmanCode_s huffmanCode){
+
+    // Variables necesarias
+    unsigned int auxWord = 0;
+
+    // Añadimos el código entero al buffer de bits de 64 bits
+    bitWriter->bitBuffer = (bitWriter->bitBuffer << huffmanCode.codeLength) | huffmanCode.code;
+    bitWriter->bitsInBuffer += huffmanCode.codeLength;
+
+    // Cuando tenemos al menos 32 bits volcamos los 32 más antiguos de más significativo a menos significativo
+    // Como los códigos no superan los 24 bits el buffer nunca llega a desbordarse
+    if(bitWriter->bitsInBuffer >= BIT_BUFFER_FLUSH_BITS){
+
+        bitWriter->bitsInBuffer -= BIT_BUFFER_FLUSH_BITS;
+        auxWord = (unsigned int)(bitWriter->bitBuffer >> bitWriter->bitsInBuffer);
+
+        bitWriter->position[0] = auxWord >> 24;
+        bitWriter->position[1] = auxWord >> 16;
+        bitWriter->position[2] = auxWord >> 8;
+        bitWriter->position[3] = auxWord;
+        bitWriter->position += sizeof(auxWord);
+
+    }
+
+}
+
+// flushBitWriter
+static void flushBitWriter(BitWriter_s *bitWriter){
+
+    // Volcamos los bits restantes byte a byte rellenando con 0 el último byte
+    while(bitWriter->bitsInBuffer > 0){
+
+        if(bitWriter->bitsInBuffer >= BITS_IN_BYTE)
+            *bitWriter->position = (byte)(bitWriter->bitBuffer >> (bitWriter->bitsInBuffer - BITS_IN_BYTE));
+        else
+            *bitWriter->position = (byte)(bitWriter->bitBuffer << (BITS_IN_BYTE - bitWriter->bitsInBuffer));
+
+        bitWriter->position++;
+        bitWriter->bitsInBuffer -= BITS_IN_BYTE;
+
+    }
+
+    bitWriter->bitsInBuffer = 0;
+
+}
+
+// getCodeLengthsHeaderLength
+static int getCodeLengthsHeaderLength(const byte *buffer, size_t bufferLength){
+
+    // Variables necesarias
+    int firstSymbol = 0;
+    int lastSymbol = 0;
+    int lengthBits = 0;
+
+    // Leemos el inicio de la cabecera: primer símbolo y último símbolo (16 bits, little endian) y bits por longitud
+    if(bufferLength < CODE_LENGTHS_HEADER_START)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    firstSymbol = buffer[0] | (buffer[1] << 8);
+    lastSymbol = buffer[2] | (buffer[3] << 8);
+    lengthBits = buffer[4];
+
+    // Con los cinco bytes a 0 el bloque es de orden 1 y detrás van la longitud de las tablas de contexto (32 bits) y las tablas
+    if(lengthBits == 0 && firstSymbol == 0 && lastSymbol == 0){
+
+        if(bufferLength < CODE_LENGTHS_HEADER_START + sizeof(unsigned int))
+            return HUFFMAN_ERROR_INCOMPLETE;
+
+        if(loadUInt32(buffer + CODE_LENGTHS_HEADER_START) > CONTEXT_HEADER_MAX)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        return CODE_LENGTHS_HEADER_START + sizeof(unsigned int) + loadUInt32(buffer + CODE_LENGTHS_HEADER_START);
+
+    }
+
+    // Con el primer símbolo fuera del alfabeto (256) el bloque es de LZ77 y detrás van la longitud de sus tres tablas (32 bits) y las tablas
+    if(lengthBits == 0 && firstSymbol == LZ_BLOCK_MARKER && lastSymbol == 0){
+
+        if(bufferLength < CODE_LENGTHS_HEADER_START + sizeof(unsigned int))
+            return HUFFMAN_ERROR_INCOMPLETE;
+
+        if(loadUInt32(buffer + CODE_LENGTHS_HEADER_START) > LZ_TABLES_NUMBER * CODE_LENGTHS_HEADER_MAX)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        return CODE_LENGTHS_HEADER_START + sizeof(unsigned int) + loadUInt32(buffer + CODE_LENGTHS_HEADER_START);
+
+    }
+
+    // Con el primer símbolo a 257 el bloque lleva puntos de acceso y detrás va el bloque con su contenido
+    if(lengthBits == 0 && firstSymbol == CHECKPOINT_BLOCK_MARKER && lastSymbol == 0)
+        return CODE_LENGTHS_HEADER_START;
+
+    // Con el primer símbolo a 0 y el último distinto de 0 el bloque está transformado y el último símbolo es la cadena de
+    // transformaciones (4 bits por transformación, la primera en los bits bajos)
+    if(lengthBits == 0 && firstSymbol == 0){
+
+        for(int chain = lastSymbol; chain != 0; chain >>= TRANSFORM_BITS)
+            if((chain & TRANSFORM_MASK) < HUFFMAN_TRANSFORM_RLE || (chain & TRANSFORM_MASK) > HUFFMAN_TRANSFORM_MTF)
+                return HUFFMAN_ERROR_CORRUPT;
+
+        return CODE_LENGTHS_HEADER_START;
+
+    }
+
+    // Sin bits por longitud el bloque usa una tabla estática y la cabecera son solo esos cinco bytes
+    if(lengthBits == 0)
+        return (firstSymbol > 0 && firstSymbol <= HUFFMAN_MAX_TABLE_ID && lastSymbol == 0) ? CODE_LENGTHS_HEADER_START : HUFFMAN_ERROR_CORRUPT;
+
+    if(firstSymbol > lastSymbol || lastSymbol >= SYMBOLS_NUMBER || lengthBits < 1 || lengthBits > BITS_IN_BYTE)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // La cabecera ocupa esos cinco bytes más las longitudes empaquetadas
+    return CODE_LENGTHS_HEADER_START + ((lastSymbol - firstSymbol + 1) * lengthBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+}
+
+// unpackCodeLengths
+static int unpackCodeLengths(const byte *buffer, int *codeLengths){
+
+    // Variables necesarias
+    int firstSymbol = 0;
+    int lastSymbol = 0;
+    int lengthBits = 0;
+    int bitCounter = 0;
+
+    firstSymbol = buffer[0] | (buffer[1] << 8);
+    lastSymbol = buffer[2] | (buffer[3] << 8);
+    lengthBits = buffer[4];
+
+    // Desempaquetamos las longitudes del rango, el resto de bytes no tienen código
+    memset(codeLengths, 0, SYMBOLS_NUMBER * sizeof(int));
+
+    for(int i = firstSymbol; i <= lastSymbol; i++){
+
+        for(int j = 0; j < lengthBits; j++){
+
+            codeLengths[i] = (codeLengths[i] << 1) | ((buffer[CODE_LENGTHS_HEADER_START + bitCounter / BITS_IN_BYTE] >> (BITS_IN_BYTE - 1 - bitCounter % BITS_IN_BYTE)) & 0b1);
+            bitCounter++;
+
+        }
+
+        if(codeLengths[i] > MAX_CODE_LENGTH)
+            return HUFFMAN_ERROR_CORRUPT;
+
+    }
+
+    return 0;
+
+}
+
+// decodeBlock
+static void decodeBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *decodeTable, byte *decodedContent){
+
+    // Variables necesarias
+    BitReader_s bitReader;
+    DecodeTable_s decodeTableCopy = *decodeTable;
+    int decodedContentLength = 0;
+    int iterations = 0;
+
+    initBitReader(&bitReader, encodedContent, encodedLength);
+
+    // Mientras queden bytes de sobra cada recarga del buffer da para dos caracteres sin comprobar nada más
+    while(charactersNumber - decodedContentLength >= 2 && (iterations = getFastIterations(&bitReader)) > 0){
+
+        if(iterations > (charactersNumber - decodedContentLength) / 2)
+            iterations = (charactersNumber - decodedContentLength) / 2;
+
+        for(int i = 0; i < iterations; i++){
+
+            loadBitReader(&bitReader);
+            decodedContent[decodedContentLength] = lookupSymbol(&bitReader, &decodeTableCopy);
+            decodedContent[decodedContentLength + 1] = lookupSymbol(&bitReader, &decodeTableCopy);
+            decodedContentLength += 2;
+
+        }
+
+    }
+
+    // El final del flujo se descifra carácter a carácter comprobando cada recarga
+    while(decodedContentLength < charactersNumber){
+
+        decodedContent[decodedContentLength] = decodeSymbol(&bitReader, &decodeTableCopy);
+        decodedContentLength++;
+
+    }
+
+}
+
+// decodeStreams
+static int decodeStreams(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *decodeTable, byte *decodedContent){
+
+    // Variables necesarias
+    BitReader_s bitReaders[HUFFMAN_MAX_STREAMS_NUMBER];
+    int streamsNumber = 0;
+    int jumpTableLength = 0;
+    int segmentLength = 0;
+    int lastSegmentLength = 0;
+    int decodedSegmentLength = 0;
+    long long streamStart = 0;
+    unsigned int streamLength = 0;
+
+    // Leemos el número de flujos y comprobamos que la tabla de saltos no se sale del contenido
+    if(encodedLength < 1)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    streamsNumber = encodedContent[0];
+    jumpTableLength = 1 + (streamsNumber - 1) * sizeof(unsigned int);
+
+    if(streamsNumber < 2 || streamsNumber > HUFFMAN_MAX_STREAMS_NUMBER || encodedLength < jumpTableLength)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Cada flujo descifra un tramo consecutivo del bloque y todos menos el último tienen la misma cantidad de caracteres
+    segmentLength = (charactersNumber + streamsNumber - 1) / streamsNumber;
+    lastSegmentLength = charactersNumber - (streamsNumber - 1) * segmentLength;
+
+    if(lastSegmentLength < 0)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Situamos un lector de bits al inicio de cada flujo (El último ocupa lo que queda del contenido)
+    streamStart = jumpTableLength;
+
+    for(int i = 0; i < streamsNumber; i++){
+
+        streamLength = (i < streamsNumber - 1) ? loadUInt32(encodedContent + 1 + i * sizeof(unsigned int)) : (unsigned int)(encodedLength - streamStart);
+
+        if(streamLength > encodedLength - streamStart)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        initBitReader(&bitReaders[i], encodedContent + streamStart, streamLength);
+        streamStart += streamLength;
+
+    }
+
+    // En cada iteración avanzamos todos los flujos un carácter, así las consultas de unos y otros no dependen entre sí
+    // y el procesador puede solaparlas. Con 4 flujos (El caso habitual) hay un bucle desenrollado que evita las comprobaciones
+    if(streamsNumber == 4)
+        decodedSegmentLength = decodeFourStreams(bitReaders, segmentLength, lastSegmentLength, decodeTable, decodedContent);
+
+    for(int i = decodedSegmentLength; i < lastSegmentLength; i++)
+        for(int j = 0; j < streamsNumber; j++)
+            decodedContent[j * segmentLength + i] = decodeSymbol(&bitReaders[j], decodeTable);
+
+    // Terminamos los caracteres que les quedan a los flujos con el tramo completo
+    for(int j = 0; j < streamsNumber - 1; j++)
+        for(int i = lastSegmentLength; i < segmentLength; i++)
+            decodedContent[j * segmentLength + i] = decodeSymbol(&bitReaders[j], decodeTable);
+
+    return 0;
+
+}
+
+// decodeFourStreams
+static int decodeFourStreams(BitReader_s *bitReaders, int segmentLength, int lastSegmentLength, DecodeTable_s *decodeTable, byte *decodedContent){
+
+    // Variables necesarias
+    BitReader_s firstReader = bitReaders[0];
+    BitReader_s secondReader = bitReaders[1];
+    BitReader_s thirdReader = bitReaders[2];
+    BitReader_s fourthReader = bitReaders[3];
+    DecodeTable_s decodeTableCopy = *decodeTable;
+    byte *firstSegment = decodedContent;
+    byte *secondSegment = decodedContent + segmentLength;
+    byte *thirdSegment = decodedContent + 2 * segmentLength;
+    byte *fourthSegment = decodedContent + 3 * segmentLength;
+    int decodedSegmentLength = 0;
+    int iterations = 0;
+
+    // Los lectores se copian en variables locales para que vivan en registros y no en memoria
+    // En cada vuelta recargamos los cuatro buffers y sacamos dos caracteres de cada uno, mientras a ningún flujo le falten bytes
+    while(lastSegmentLength - decodedSegmentLength >= 2){
+
+        iterations = (lastSegmentLength - decodedSegmentLength) / 2;
+
+        if(getFastIterations(&firstReader) < iterations)
+            iterations = getFastIterations(&firstReader);
+
+        if(getFastIterations(&secondReader) < iterations)
+            iterations = getFastIterations(&secondReader);
+
+        if(getFastIterations(&thirdReader) < iterations)
+            iterations = getFastIterations(&thirdReader);
+
+        if(getFastIterations(&fourthReader) < iterations)
+            iterations = getFastIterations(&fourthReader);
+
+        if(iterations <= 0)
+            break;
+
+        for(int i = 0; i < iterations; i++){
+
+            loadBitReader(&firstReader);
+            loadBitReader(&secondReader);
+            loadBitReader(&thirdReader);
+            loadBitReader(&fourthReader);
+
+            firstSegment[decodedSegmentLength] = lookupSymbol(&firstReader, &decodeTableCopy);
+            secondSegment[decodedSegmentLength] = lookupSymbol(&secondReader, &decodeTableCopy);
+            thirdSegment[decodedSegmentLength] = lookupSymbol(&thirdReader, &decodeTableCopy);
+            fourthSegment[decodedSegmentLength] = lookupSymbol(&fourthReader, &decodeTableCopy);
+
+            firstSegment[decodedSegmentLength + 1] = lookupSymbol(&firstReader, &decodeTableCopy);
+            secondSegment[decodedSegmentLength + 1] = lookupSymbol(&secondReader, &decodeTableCopy);
+            thirdSegment[decodedSegmentLength + 1] = lookupSymbol(&thirdReader, &decodeTableCopy);
+            fourthSegment[decodedSegmentLength + 1] = lookupSymbol(&fourthReader, &decodeTableCopy);
+
+            decodedSegmentLength += 2;
+
+        }
+
+    }
+
+    // Devolvemos el estado de los lectores para que el resto de caracteres se descifren con comprobaciones
+    bitReaders[0] = firstReader;
+    bitReaders[1] = secondReader;
+    bitReaders[2] = thirdReader;
+    bitReaders[3] = fourthReader;
+
+    return decodedSegmentLength;
+
+}
+
+// encodeEntropyBlock
+static long long encodeEntropyBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    int huffmanCodesMaxLength = 0;
+    unsigned long long payloadBits = 0;
+    size_t encodedBlockLength = 0;
+    long long alternativeBlockLength = 0;
+    int streamsNumber = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(encoder == NULL || sourceLength < 0 || (source == NULL && sourceLength > 0) || destination == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    // Con una tabla estática los códigos ya están calculados en el contexto, así que no hace falta histograma ni árbol
+    if(encoder->staticTableId != 0)
+        return encodeStaticBlock(encoder, source, sourceLength, destination, capacity);
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Rellenamos la tabla de frecuencias (Una entrada por cada valor posible de un byte) con el bloque
+    // Los bloques grandes se reparten entre los hilos del contexto
+    // En el modo de orden 1 contamos cada byte según el anterior y el histograma global sale de esas cuentas
+    if(encoder->contextOrder == 1)
+        countContextFrequencies(source, sourceLength, encoder->contextFrequencyTables, encoder->frequencyTable);
+    else if(encoder->threadsNumber > 1 && sourceLength >= HISTOGRAM_SPLIT_MIN_LENGTH)
+        countFrequenciesInParallel(encoder, source, sourceLength);
+    else
+        countFrequencies(source, sourceLength, encoder->frequencyTable);
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.histogram, &encoder->stats->cpuTimes.histogram);
+
+    // Ordenamos los caracteres por frecuencia
+    encoder->charactersNumber = sortCharactersByFrequency(encoder->frequencyTable, encoder->sortedCharacters);
+
+    // Creamos el árbol con los nodos de las letras sobre el árbol del contexto, sin reservar memoria
+    buildTree(encoder->sortedCharacters, encoder->charactersNumber, &encoder->huffmanTree);
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.treeBuild, &encoder->stats->cpuTimes.treeBuild);
+
+    // Creamos la tabla de códigos huffman indexada directamente por el valor del byte
+    // Del árbol solo tomamos la longitud de cada código, los códigos se asignan de forma canónica
+    initHuffmanCodes(encoder->huffmanCodes);
+    huffmanCodesMaxLength = generateHuffmanCodes(encoder->huffmanCodes, &encoder->huffmanTree);
+
+    // Si algún código supera la longitud máxima recalculamos las longitudes con el límite
+    if(huffmanCodesMaxLength > encoder->maxCodeLength){
+
+        if(encoder->stats != NULL && encoder->packageItems == NULL)
+            encoder->stats->allocationsNumber++;
+
+        huffmanCodesMaxLength = limitCodeLengths(encoder);
+
+    }
+
+    assignCanonicalCodes(encoder->huffmanCodes, huffmanCodesMaxLength);
+
+    // Con las longitudes ya conocemos lo que ocupará el bloque, así que comprobamos que cabe antes de escribir nada
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        payloadBits += (unsigned long long)encoder->frequencyTable[i] * encoder->huffmanCodes[i].codeLength;
+
+    encodedBlockLength = 2 * sizeof(unsigned int) + packCodeLengths(encoder->huffmanCodes, NULL) + (payloadBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    // Los bloques pequeños van en un único flujo porque la tabla de saltos no compensaría
+    // Con varios flujos se añaden la tabla de saltos y como mucho un byte de relleno más por flujo
+    streamsNumber = (sourceLength >= encoder->streamsNumber * STREAM_MIN_LENGTH) ? encoder->streamsNumber : 1;
+
+    if(streamsNumber > 1)
+        encodedBlockLength += 1 + (streamsNumber - 1) * sizeof(unsigned int) + streamsNumber - 1;
+
+    if(encodedBlockLength > capacity)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.codeGeneration, &encoder->stats->cpuTimes.codeGeneration);
+
+    // Con LZ77 el bloque solo se guarda como secuencias de coincidencias si así ocupa menos que con la tabla única
+    if(encoder->lzLevel > 0){
+
+        if((alternativeBlockLength = encodeLzBlock(encoder, source, sourceLength, encodedBlockLength, destination)) > 0)
+            return alternativeBlockLength;
+
+        if(encoder->stats != NULL)
+            huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.codeGeneration, &encoder->stats->cpuTimes.codeGeneration);
+
+    }
+
+    // En el modo de orden 1 el bloque solo usa tablas por contexto si con ellas ocupa menos que con la tabla única
+    // Si no compensan el tiempo de calcularlas cuenta como generación de códigos del bloque normal
+    if(encoder->contextOrder == 1){
+
+        if((alternativeBlockLength = encodeContextBlock(encoder, source, sourceLength, encodedBlockLength, destination)) > 0)
+            return alternativeBlockLength;
+
+        if(encoder->stats != NULL)
+            huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.codeGeneration, &encoder->stats->cpuTimes.codeGeneration);
+
+    }
+
+    // Codificamos el bloque
+    encodedBlockLength = encodeBlock(source, sourceLength, encoder->huffmanCodes, 0, streamsNumber, destination);
+
+    // Anotamos los contadores del bloque
+    if(encoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.encode, &encoder->stats->cpuTimes.encode);
+
+        encoder->stats->blocksNumber++;
+        encoder->stats->symbolsNumber += sourceLength;
+        encoder->stats->payloadBits += payloadBits;
+
+        if(huffmanCodesMaxLength > encoder->stats->maxCodeLength)
+            encoder->stats->maxCodeLength = huffmanCodesMaxLength;
+
+        if(sourceLength > 0 && encoder->charactersNumber > encoder->stats->maxDistinctSymbols)
+            encoder->stats->maxDistinctSymbols = encoder->charactersNumber;
+
+    }
+
+    return encodedBlockLength;
+
+}
+
+// decodeEntropyBlock
+static long long decodeEntropyBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    long long neededLength = 0;
+    int charactersNumber = 0;
+    int headerLength = 0;
+    int status = 0;
+    HuffmanStageClock_s stageClock;
+    int decodeTableCapacity = 0;
+    int distinctSymbols = 0;
+    DecodeTable_s *decodeTable = NULL;
+    int blockType = 0;
+    int codesMaxLength = 0;
+
+    if(decoder == NULL || frame == NULL)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // El bloque debe estar completo y caber en el destino
+    neededLength = huffmanGetBlockFrameLength(frame, frameLength, &charactersNumber);
+
+    if(neededLength < 0)
+        return neededLength;
+
+    if(neededLength == 0)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if((size_t)neededLength > frameLength)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if((size_t)charactersNumber > capacity || (destination == NULL && charactersNumber > 0))
+        return HUFFMAN_ERROR_CAPACITY;
+
+    headerLength = getCodeLengthsHeaderLength(frame + sizeof(unsigned int), frameLength - sizeof(unsigned int));
+    decodeTableCapacity = decoder->decodeTable.capacity;
+
+    if((blockType = loadBlockTables(decoder, frame, headerLength, &decodeTable, &codesMaxLength)) < 0)
+        return blockType;
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &decoder->stats->wallTimes.decodeTable, &decoder->stats->cpuTimes.decodeTable);
+
+    // Desciframos el contenido (Lo que queda del bloque tras la longitud del contenido)
+    if(blockType == BLOCK_TYPE_LZ){
+
+        if((status = decodeLzBlock(frame + 2 * sizeof(unsigned int) + headerLength, neededLength - 2 * sizeof(unsigned int) - headerLength, charactersNumber, decoder->lzDecodeTables, destination)) < 0)
+            return status;
+
+    }
+    else if(blockType == BLOCK_TYPE_CONTEXT)
+        decodeContextBlock(frame + 2 * sizeof(unsigned int) + headerLength, neededLength - 2 * sizeof(unsigned int) - headerLength, charactersNumber, decoder->contextTables, destination);
+    else if(loadUInt32(frame) & MULTI_STREAM_FLAG){
+
+        if((status = decodeStreams(frame + 2 * sizeof(unsigned int) + headerLength, neededLength - 2 * sizeof(unsigned int) - headerLength, charactersNumber, decodeTable, destination)) < 0)
+            return status;
+
+    }
+    else
+        decodeBlock(frame + 2 * sizeof(unsigned int) + headerLength, neededLength - 2 * sizeof(unsigned int) - headerLength, charactersNumber, decodeTable, destination);
+
+    // Anotamos los contadores del bloque (Los bits del contenido incluyen el relleno del último byte)
+    if(decoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &decoder->stats->wallTimes.decode, &decoder->stats->cpuTimes.decode);
+
+        decoder->stats->blocksNumber++;
+        decoder->stats->symbolsNumber += charactersNumber;
+        decoder->stats->payloadBits += (neededLength - 2 * sizeof(unsigned int) - headerLength) * BITS_IN_BYTE;
+
+        if(decoder->decodeTable.capacity != decodeTableCapacity)
+            decoder->stats->allocationsNumber++;
+
+        // En una tabla estática todos los bytes tienen código, así que no dice cuántos distintos tiene el bloque
+        if(blockType != BLOCK_TYPE_NORMAL){
+
+            if(codesMaxLength > decoder->stats->maxCodeLength)
+                decoder->stats->maxCodeLength = codesMaxLength;
+
+        }
+        else{
+
+            for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+                if(decoder->codeLengths[i] > decoder->stats->maxCodeLength)
+                    decoder->stats->maxCodeLength = decoder->codeLengths[i];
+
+                if(decoder->codeLengths[i] > 0)
+                    distinctSymbols++;
+
+            }
+
+            if(charactersNumber > 0 && distinctSymbols > decoder->stats->maxDistinctSymbols)
+                decoder->stats->maxDistinctSymbols = distinctSymbols;
+
+        }
+
+    }
+
+    return charactersNumber;
+
+}
+
+// loadBlockTables
+static int loadBlockTables(HuffmanDecoder_s *decoder, const byte *frame, int headerLength, DecodeTable_s **decodeTable, int *codesMaxLength){
+
+    // Variables necesarias
+    int tableId = 0;
+    int status = 0;
+
+    // Si el bloque es de LZ77 construimos las tablas de las secuencias, los literales y las distancias (Siempre en un único flujo)
+    if(frame[sizeof(unsigned int) + CODE_LENGTHS_HEADER_START - 1] == 0 && (frame[sizeof(unsigned int)] | (frame[sizeof(unsigned int) + 1] << BITS_IN_BYTE)) == LZ_BLOCK_MARKER){
+
+        if(loadUInt32(frame) & MULTI_STREAM_FLAG)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        if((*codesMaxLength = loadLzTables(decoder, frame + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + sizeof(unsigned int), headerLength - CODE_LENGTHS_HEADER_START - sizeof(unsigned int))) < 0)
+            return *codesMaxLength;
+
+        return BLOCK_TYPE_LZ;
+
+    }
+
+    // Si el bloque es de orden 1 construimos la tabla compartida y las de los contextos que tienen la suya (Siempre en un único flujo)
+    if(frame[sizeof(unsigned int) + CODE_LENGTHS_HEADER_START - 1] == 0 && frame[sizeof(unsigned int)] == 0){
+
+        if(loadUInt32(frame) & MULTI_STREAM_FLAG)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        if((*codesMaxLength = loadContextTables(decoder, frame + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + sizeof(unsigned int), headerLength - CODE_LENGTHS_HEADER_START - sizeof(unsigned int))) < 0)
+            return *codesMaxLength;
+
+        return BLOCK_TYPE_CONTEXT;
+
+    }
+
+    // Si el bloque usa una tabla estática consultamos la tabla de descifrado que se construyó al cargarla
+    // Las tablas de la biblioteca se cargan la primera vez que aparecen y las del usuario deben cargarse antes
+    if(frame[sizeof(unsigned int) + CODE_LENGTHS_HEADER_START - 1] == 0){
+
+        if(frame[sizeof(unsigned int) + 1] != 0)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        tableId = frame[sizeof(unsigned int)];
+
+        if(decoder->staticTables[tableId] == NULL && tableId <= HUFFMAN_BUILTIN_TABLES_NUMBER)
+            huffmanAddDecoderStaticTable(decoder, tableId, NULL);
+
+        if(decoder->staticTables[tableId] == NULL)
+            return HUFFMAN_ERROR_TABLE;
+
+        *decodeTable = &decoder->staticTables[tableId]->decodeTable;
+        *codesMaxLength = decoder->staticTables[tableId]->codesMaxLength;
+
+        return BLOCK_TYPE_STATIC;
+
+    }
+
+    // Si no, reconstruimos el árbol canónico y la tabla de descifrado sobre la memoria del contexto
+    if((status = unpackCodeLengths(frame + sizeof(unsigned int), decoder->codeLengths)) < 0)
+        return status;
+
+    if((status = buildTreeFromCodeLengths(decoder->codeLengths, &decoder->huffmanTree)) < 0)
+        return status;
+
+    if(buildDecodeTable(&decoder->huffmanTree, &decoder->decodeTable) < 0)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    *decodeTable = &decoder->decodeTable;
+
+    return BLOCK_TYPE_NORMAL;
+
+}
+
+// encodeContextBlock
+static long long encodeContextBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, size_t order0Length, byte *destination){
+
+    // Variables necesarias
+    HuffmanCode_s order0Codes[SYMBOLS_NUMBER];
+    unsigned int order0FrequencyTable[SYMBOLS_NUMBER];
+    int order0CharactersNumber = encoder->charactersNumber;
+    unsigned int sharedFrequencyTable[SYMBOLS_NUMBER] = {0};
+    unsigned int contextSymbols = 0;
+    HuffmanCode_s *sharedCodes = encoder->contextCodes + (size_t)SYMBOLS_NUMBER * SYMBOLS_NUMBER;
+    HuffmanCode_s *contextCodes[SYMBOLS_NUMBER];
+    unsigned int *frequencyTable = NULL;
+    unsigned long long contextBits = 0;
+    unsigned long long order0Bits = 0;
+    unsigned long long payloadBits = 0;
+    size_t headersLength = 0;
+    size_t encodedBlockLength = 0;
+    int tablesNumber = 0;
+    int codesMaxLength = 0;
+    int tableMaxLength = 0;
+    int position = 0;
+    BitWriter_s bitWriter;
+    byte previous = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Guardamos los códigos de orden 0 del bloque para compararlos y para dejarlos como estaban si no compensa
+    memcpy(order0Codes, encoder->huffmanCodes, sizeof(order0Codes));
+    memcpy(order0FrequencyTable, encoder->frequencyTable, sizeof(order0FrequencyTable));
+
+    // Un contexto tiene tabla propia si con ella sus bytes más la tabla ocupan menos que con los códigos de orden 0
+    // Los contextos con pocos bytes y los que no compensan comparten una única tabla con la suma de sus cuentas
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        frequencyTable = encoder->contextFrequencyTables + (size_t)i * SYMBOLS_NUMBER;
+        contextCodes[i] = sharedCodes;
+        contextSymbols = 0;
+        order0Bits = 0;
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++){
+
+            contextSymbols += frequencyTable[j];
+            order0Bits += (unsigned long long)frequencyTable[j] * order0Codes[j].codeLength;
+
+        }
+
+        if(contextSymbols >= CONTEXT_MIN_SYMBOLS){
+
+            tableMaxLength = buildCodesFromFrequencies(encoder, frequencyTable, encoder->contextCodes + (size_t)i * SYMBOLS_NUMBER);
+            contextBits = (unsigned long long)packCodeLengths(encoder->contextCodes + (size_t)i * SYMBOLS_NUMBER, NULL) * BITS_IN_BYTE;
+
+            for(int j = 0; j < SYMBOLS_NUMBER; j++)
+                contextBits += (unsigned long long)frequencyTable[j] * encoder->contextCodes[(size_t)i * SYMBOLS_NUMBER + j].codeLength;
+
+            if(contextBits < order0Bits){
+
+                contextCodes[i] = encoder->contextCodes + (size_t)i * SYMBOLS_NUMBER;
+                payloadBits += contextBits - packCodeLengths(contextCodes[i], NULL) * BITS_IN_BYTE;
+                headersLength += packCodeLengths(contextCodes[i], NULL);
+                tablesNumber++;
+
+                if(tableMaxLength > codesMaxLength)
+                    codesMaxLength = tableMaxLength;
+
+                continue;
+
+            }
+
+        }
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            sharedFrequencyTable[j] += frequencyTable[j];
+
+    }
+
+    // La tabla compartida siempre va en el bloque, así que si todos los contextos tienen la suya usamos las cuentas del bloque
+    if(tablesNumber > 0){
+
+        contextSymbols = 0;
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            contextSymbols += sharedFrequencyTable[j];
+
+        tableMaxLength = buildCodesFromFrequencies(encoder, (contextSymbols > 0) ? sharedFrequencyTable : order0FrequencyTable, sharedCodes);
+        headersLength += packCodeLengths(sharedCodes, NULL);
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            payloadBits += (unsigned long long)sharedFrequencyTable[j] * sharedCodes[j].codeLength;
+
+        if(tableMaxLength > codesMaxLength)
+            codesMaxLength = tableMaxLength;
+
+        encodedBlockLength = 3 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + CONTEXT_BITMAP_LENGTH + headersLength + (payloadBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    }
+
+    memcpy(encoder->huffmanCodes, order0Codes, sizeof(order0Codes));
+    memcpy(encoder->frequencyTable, order0FrequencyTable, sizeof(order0FrequencyTable));
+    encoder->charactersNumber = order0CharactersNumber;
+
+    if(tablesNumber == 0 || encodedBlockLength >= order0Length)
+        return 0;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.codeGeneration, &encoder->stats->cpuTimes.codeGeneration);
+
+    // Número de caracteres, la marca de orden 1 (Cinco bytes a 0) y la longitud de las tablas de contexto
+    storeUInt32(destination, sourceLength);
+    memset(destination + sizeof(unsigned int), 0, CODE_LENGTHS_HEADER_START);
+    storeUInt32(destination + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START, CONTEXT_BITMAP_LENGTH + headersLength);
+    position = 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START;
+
+    // Mapa de bits con los contextos que tienen tabla propia, la tabla compartida y las propias en orden de byte
+    memset(destination + position, 0, CONTEXT_BITMAP_LENGTH);
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        if(contextCodes[i] != sharedCodes)
+            destination[position + i / BITS_IN_BYTE] |= 0x80 >> (i % BITS_IN_BYTE);
+
+    position += CONTEXT_BITMAP_LENGTH;
+    position += packCodeLengths(sharedCodes, destination + position);
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        if(contextCodes[i] != sharedCodes)
+            position += packCodeLengths(contextCodes[i], destination + position);
+
+    // Longitud del contenido y el contenido, cada byte con la tabla del anterior
+    storeUInt32(destination + position, (payloadBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+    position += sizeof(unsigned int);
+
+    bitWriter.position = destination + position;
+    bitWriter.bitBuffer = 0;
+    bitWriter.bitsInBuffer = 0;
+
+    for(int i = 0; i < sourceLength; i++){
+
+        writeCode(&bitWriter, contextCodes[previous][source[i]]);
+        previous = source[i];
+
+    }
+
+    flushBitWriter(&bitWriter);
+
+    // Anotamos los contadores del bloque
+    if(encoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.encode, &encoder->stats->cpuTimes.encode);
+
+        encoder->stats->blocksNumber++;
+        encoder->stats->symbolsNumber += sourceLength;
+        encoder->stats->payloadBits += payloadBits;
+
+        if(codesMaxLength > encoder->stats->maxCodeLength)
+            encoder->stats->maxCodeLength = codesMaxLength;
+
+        if(order0CharactersNumber > encoder->stats->maxDistinctSymbols)
+            encoder->stats->maxDistinctSymbols = order0CharactersNumber;
+
+    }
+
+    return bitWriter.position - destination;
+
+}
+
+// loadContextTables
+static int loadContextTables(HuffmanDecoder_s *decoder, const byte *buffer, int length){
+
+    // Variables necesarias
+    int position = CONTEXT_BITMAP_LENGTH;
+    int tableLength = 0;
+    int context = 0;
+    int status = 0;
+    int codesMaxLength = 0;
+
+    // Las 257 tablas de descifrado se reservan la primera vez que llega un bloque de orden 1 y se reutilizan
+    if(decoder->contextDecodeTables == NULL){
+
+        decoder->contextDecodeTables = (DecodeTable_s*)calloc(SYMBOLS_NUMBER + 1, sizeof(DecodeTable_s));
+
+        if(decoder->contextDecodeTables == NULL)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        if(decoder->stats != NULL)
+            decoder->stats->allocationsNumber++;
+
+    }
+
+    if(length < CONTEXT_BITMAP_LENGTH)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Primero va la tabla compartida (La última posición) y después las de los contextos marcados en el mapa de bits
+    for(int i = 0; i <= SYMBOLS_NUMBER; i++){
+
+        context = (i == 0) ? SYMBOLS_NUMBER : i - 1;
+
+        if(context < SYMBOLS_NUMBER && !(buffer[context / BITS_IN_BYTE] & (0x80 >> (context % BITS_IN_BYTE)))){
+
+            decoder->contextTables[context] = &decoder->contextDecodeTables[SYMBOLS_NUMBER];
+            continue;
+
+        }
+
+        // Cada tabla es una cabecera de longitudes normal que debe caber entera en las tablas de contexto
+        tableLength = getCodeLengthsHeaderLength(buffer + position, length - position);
+
+        if(tableLength < 0 || buffer[position + CODE_LENGTHS_HEADER_START - 1] == 0 || tableLength > length - position)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        if((status = unpackCodeLengths(buffer + position, decoder->codeLengths)) < 0)
+            return status;
+
+        if((status = buildTreeFromCodeLengths(decoder->codeLengths, &decoder->huffmanTree)) < 0)
+            return status;
+
+        if(buildDecodeTable(&decoder->huffmanTree, &decoder->contextDecodeTables[context]) < 0)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        if(context < SYMBOLS_NUMBER)
+            decoder->contextTables[context] = &decoder->contextDecodeTables[context];
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            if(decoder->codeLengths[j] > codesMaxLength)
+                codesMaxLength = decoder->codeLengths[j];
+
+        position += tableLength;
+
+    }
+
+    return (position == length) ? codesMaxLength : HUFFMAN_ERROR_CORRUPT;
+
+}
+
+// decodeContextBlock
+static void decodeContextBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s **contextTables, byte *decodedContent){
+
+    // Variables necesarias
+    BitReader_s bitReader;
+    byte previous = 0;
+    int decodedContentLength = 0;
+    int iterations = 0;
+
+    initBitReader(&bitReader, encodedContent, encodedLength);
+
+    // Igual que un bloque normal, pero cada carácter se busca en la tabla del contexto que deja el anterior
+    while(charactersNumber - decodedContentLength >= 2 && (iterations = getFastIterations(&bitReader)) > 0){
+
+        if(iterations > (charactersNumber - decodedContentLength) / 2)
+            iterations = (charactersNumber - decodedContentLength) / 2;
+
+        for(int i = 0; i < iterations; i++){
+
+            loadBitReader(&bitReader);
+            previous = decodedContent[decodedContentLength] = lookupSymbol(&bitReader, contextTables[previous]);
+            previous = decodedContent[decodedContentLength + 1] = lookupSymbol(&bitReader, contextTables[previous]);
+            decodedContentLength += 2;
+
+        }
+
+    }
+
+    while(decodedContentLength < charactersNumber){
+
+        previous = decodedContent[decodedContentLength] = decodeSymbol(&bitReader, contextTables[previous]);
+        decodedContentLength++;
+
+    }
+
+}
+
+// encodeLzBlock
+static long long encodeLzBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, size_t order0Length, byte *destination){
+
+    // Variables necesarias
+    HuffmanCode_s order0Codes[SYMBOLS_NUMBER];
+    unsigned int order0FrequencyTable[SYMBOLS_NUMBER];
+    int order0CharactersNumber = encoder->charactersNumber;
+    unsigned int frequencyTables[LZ_TABLES_NUMBER][SYMBOLS_NUMBER];
+    HuffmanCode_s lzCodes[LZ_TABLES_NUMBER][SYMBOLS_NUMBER];
+    LzSequence_s *sequence = NULL;
+    int sequencesNumber = 0;
+    int matchesNumber = 0;
+    const byte *literal = source;
+    int literalsCode = 0;
+    int matchCode = 0;
+    int distanceCode = 0;
+    int literalsExtraBits = 0;
+    int matchExtraBits = 0;
+    int distanceExtraBits = 0;
+    unsigned long long payloadBits = 0;
+    size_t tablesLength = 0;
+    size_t encodedBlockLength = 0;
+    int codesMaxLength = 0;
+    int tableMaxLength = 0;
+    int position = 0;
+    BitWriter_s bitWriter;
+    HuffmanStageClock_s stageClock;
+
+    // Sin memoria para la búsqueda el bloque se cifra sin LZ77
+    if(sourceLength == 0 || reserveLzBuffers(encoder, sourceLength) < 0)
+        return 0;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    sequencesNumber = findLzSequences(encoder, source, sourceLength);
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.match, &encoder->stats->cpuTimes.match);
+
+    // Contamos cada alfabeto por separado: el símbolo de cada secuencia (Códigos de los literales y de la coincidencia
+    // en 4 bits cada uno), los literales y los códigos de las distancias. Los bits extra van sin codificar
+    memset(frequencyTables, 0, sizeof(frequencyTables));
+
+    for(int i = 0; i < sequencesNumber; i++){
+
+        sequence = &encoder->lzSequences[i];
+        literalsCode = getLzValueCode(sequence->literalsLength, &literalsExtraBits);
+        matchCode = (sequence->matchLength > 0) ? getLzValueCode(sequence->matchLength - LZ_MIN_MATCH_LENGTH + 1, &matchExtraBits) : 0;
+
+        frequencyTables[LZ_TOKENS_TABLE][(literalsCode << 4) | matchCode]++;
+        payloadBits += literalsExtraBits;
+
+        for(int j = 0; j < sequence->literalsLength; j++)
+            frequencyTables[LZ_LITERALS_TABLE][literal[j]]++;
+
+        literal += sequence->literalsLength + sequence->matchLength;
+
+        if(sequence->matchLength > 0){
+
+            distanceCode = getLzDistanceCode(sequence->distance, &distanceExtraBits);
+            frequencyTables[LZ_DISTANCES_TABLE][distanceCode]++;
+            payloadBits += matchExtraBits + distanceExtraBits;
+            matchesNumber++;
+
+        }
+
+    }
+
+    // Toda tabla necesita algún símbolo aunque el bloque no tenga coincidencias
+    if(matchesNumber == 0)
+        frequencyTables[LZ_DISTANCES_TABLE][0] = 1;
+
+    // Guardamos los códigos de orden 0 del bloque para compararlos y para dejarlos como estaban si no compensa
+    memcpy(order0Codes, encoder->huffmanCodes, sizeof(order0Codes));
+    memcpy(order0FrequencyTable, encoder->frequencyTable, sizeof(order0FrequencyTable));
+
+    for(int i = 0; i < LZ_TABLES_NUMBER; i++){
+
+        tableMaxLength = buildCodesFromFrequencies(encoder, frequencyTables[i], lzCodes[i]);
+        tablesLength += packCodeLengths(lzCodes[i], NULL);
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++)
+            payloadBits += (unsigned long long)frequencyTables[i][j] * lzCodes[i][j].codeLength;
+
+        if(tableMaxLength > codesMaxLength)
+            codesMaxLength = tableMaxLength;
+
+    }
+
+    memcpy(encoder->huffmanCodes, order0Codes, sizeof(order0Codes));
+    memcpy(encoder->frequencyTable, order0FrequencyTable, sizeof(order0FrequencyTable));
+    encoder->charactersNumber = order0CharactersNumber;
+
+    encodedBlockLength = 3 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + tablesLength + (payloadBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    if(encodedBlockLength >= order0Length)
+        return 0;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.codeGeneration, &encoder->stats->cpuTimes.codeGeneration);
+
+    // Número de caracteres, la marca de LZ77 (Primer símbolo 256), la longitud de las tablas y las tablas
+    storeUInt32(destination, sourceLength);
+    memset(destination + sizeof(unsigned int), 0, CODE_LENGTHS_HEADER_START);
+    destination[sizeof(unsigned int)] = LZ_BLOCK_MARKER & 0xFF;
+    destination[sizeof(unsigned int) + 1] = LZ_BLOCK_MARKER >> BITS_IN_BYTE;
+    storeUInt32(destination + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START, tablesLength);
+    position = 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START;
+
+    for(int i = 0; i < LZ_TABLES_NUMBER; i++)
+        position += packCodeLengths(lzCodes[i], destination + position);
+
+    storeUInt32(destination + position, (payloadBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+    position += sizeof(unsigned int);
+
+    // Cada secuencia: su símbolo, los bits extra de los literales, los literales y, si hay coincidencia, sus bits extra,
+    // el código de la distancia y los bits extra de la distancia
+    bitWriter.position = destination + position;
+    bitWriter.bitBuffer = 0;
+    bitWriter.bitsInBuffer = 0;
+    literal = source;
+
+    for(int i = 0; i < sequencesNumber; i++){
+
+        sequence = &encoder->lzSequences[i];
+        literalsCode = getLzValueCode(sequence->literalsLength, &literalsExtraBits);
+        matchCode = (sequence->matchLength > 0) ? getLzValueCode(sequence->matchLength - LZ_MIN_MATCH_LENGTH + 1, &matchExtraBits) : 0;
+
+        writeCode(&bitWriter, lzCodes[LZ_TOKENS_TABLE][(literalsCode << 4) | matchCode]);
+        writeCode(&bitWriter, (HuffmanCode_s){0, sequence->literalsLength & ((1U << literalsExtraBits) - 1), literalsExtraBits});
+
+        for(int j = 0; j < sequence->literalsLength; j++)
+            writeCode(&bitWriter, lzCodes[LZ_LITERALS_TABLE][literal[j]]);
+
+        literal += sequence->literalsLength + sequence->matchLength;
+
+        if(sequence->matchLength > 0){
+
+            distanceCode = getLzDistanceCode(sequence->distance, &distanceExtraBits);
+
+            writeCode(&bitWriter, (HuffmanCode_s){0, (sequence->matchLength - LZ_MIN_MATCH_LENGTH + 1) & ((1U << matchExtraBits) - 1), matchExtraBits});
+            writeCode(&bitWriter, lzCodes[LZ_DISTANCES_TABLE][distanceCode]);
+            writeCode(&bitWriter, (HuffmanCode_s){0, (sequence->distance - 1) & ((1U << distanceExtraBits) - 1), distanceExtraBits});
+
+        }
+
+    }
+
+    flushBitWriter(&bitWriter);
+
+    // Anotamos los contadores del bloque (Los símbolos son los de las tres tablas)
+    if(encoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.encode, &encoder->stats->cpuTimes.encode);
+
+        encoder->stats->blocksNumber++;
+        encoder->stats->symbolsNumber += sourceLength;
+        encoder->stats->payloadBits += payloadBits;
+
+        if(codesMaxLength > encoder->stats->maxCodeLength)
+            encoder->stats->maxCodeLength = codesMaxLength;
+
+        if(order0CharactersNumber > encoder->stats->maxDistinctSymbols)
+            encoder->stats->maxDistinctSymbols = order0CharactersNumber;
+
+    }
+
+    return bitWriter.position - destination;
+
+}
+
+// reserveLzBuffers
+static int reserveLzBuffers(HuffmanEncoder_s *encoder, int length){
+
+    // Las cabezas de las cadenas no dependen del bloque, la posición anterior de cada byte y las secuencias sí
+    // Cada secuencia con coincidencia cubre al menos 3 bytes y las de solo literales al menos LZ_MAX_VALUE salvo la última
+    if(encoder->lzHead == NULL){
+
+        if((encoder->lzHead = (int*)malloc((1 << LZ_HASH_BITS) * sizeof(int))) == NULL)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        if(encoder->stats != NULL)
+            encoder->stats->allocationsNumber++;
+
+    }
+
+    if(length <= encoder->lzCapacity)
+        return 0;
+
+    free(encoder->lzPrevious);
+    free(encoder->lzSequences);
+
+    encoder->lzPrevious = (int*)malloc((size_t)length * sizeof(int));
+    encoder->lzSequences = (LzSequence_s*)malloc(((size_t)length / 2 + 2) * sizeof(LzSequence_s));
+    encoder->lzCapacity = length;
+
+    if(encoder->stats != NULL)
+        encoder->stats->allocationsNumber += 2;
+
+    if(encoder->lzPrevious == NULL || encoder->lzSequences == NULL){
+
+        encoder->lzCapacity = 0;
+        return HUFFMAN_ERROR_CAPACITY;
+
+    }
+
+    return 0;
+
+}
+
+// findLzSequences
+static int findLzSequences(HuffmanEncoder_s *encoder, const byte *source, int sourceLength){
+
+    // Variables necesarias
+    const LzLevel_s *lzLevel = &lzLevels[encoder->lzLevel];
+    int windowSize = 1 << encoder->lzWindowBits;
+    int sequencesNumber = 0;
+    int anchor = 0;
+    int position = 0;
+    int matchLength = 0;
+    int distance = 0;
+    int nextMatchLength = 0;
+    int nextDistance = 0;
+
+    // Las cadenas se encadenan por el hash de los 3 bytes de cada posición, empezando vacías en cada bloque
+    memset(encoder->lzHead, 0xFF, (1 << LZ_HASH_BITS) * sizeof(int));
+
+    while(position + LZ_MIN_MATCH_LENGTH <= sourceLength){
+
+        matchLength = findLzMatch(source, sourceLength, position, encoder->lzHead, encoder->lzPrevious, windowSize, lzLevel->chainLength, lzLevel->niceLength, &distance);
+        insertLzPosition(source, position, encoder->lzHead, encoder->lzPrevious);
+
+        if(matchLength < LZ_MIN_MATCH_LENGTH){
+
+            position++;
+            continue;
+
+        }
+
+        // Búsqueda perezosa: si la posición siguiente tiene una coincidencia más larga dejamos esta como literal
+        while(lzLevel->isLazy && matchLength < lzLevel->niceLength && position + 1 + LZ_MIN_MATCH_LENGTH <= sourceLength){
+
+            nextMatchLength = findLzMatch(source, sourceLength, position + 1, encoder->lzHead, encoder->lzPrevious, windowSize, lzLevel->chainLength, lzLevel->niceLength, &nextDistance);
+
+            if(nextMatchLength <= matchLength)
+                break;
+
+            position++;
+            insertLzPosition(source, position, encoder->lzHead, encoder->lzPrevious);
+            matchLength = nextMatchLength;
+            distance = nextDistance;
+
+        }
+
+        addLzSequence(encoder->lzSequences, &sequencesNumber, position - anchor, matchLength, distance);
+
+        // Las posiciones dentro de la coincidencia también entran en las cadenas para las búsquedas siguientes
+        for(int i = position + 1; i < position + matchLength && i + LZ_MIN_MATCH_LENGTH <= sourceLength; i++)
+            insertLzPosition(source, i, encoder->lzHead, encoder->lzPrevious);
+
+        position += matchLength;
+        anchor = position;
+
+    }
+
+    // Los últimos bytes van como literales en una secuencia sin coincidencia
+    if(anchor < sourceLength)
+        addLzSequence(encoder->lzSequences, &sequencesNumber, sourceLength - anchor, 0, 0);
+
+    return sequencesNumber;
+
+}
+
+// findLzMatch
+static int findLzMatch(const byte *source, int sourceLength, int position, const int *head, const int *previous, int windowSize, int chainLength, int niceLength, int *distance){
+
+    // Variables necesarias
+    int bestLength = LZ_MIN_MATCH_LENGTH - 1;
+    int maxLength = sourceLength - position;
+    int length = 0;
+
+    // Recorremos las posiciones anteriores con el mismo hash, de la más cercana a la más lejana, sin salir de la ventana
+    for(int candidate = head[getLzHash(source + position)]; candidate >= 0 && position - candidate <= windowSize && chainLength-- > 0; candidate = previous[candidate]){
+
+        // Solo puede mejorar si coincide el byte que alargaría la mejor coincidencia
+        if(source[candidate + bestLength] != source[position + bestLength])
+            continue;
+
+        for(length = 0; length < maxLength && source[candidate + length] == source[position + length]; length++);
+
+        if(length > bestLength){
+
+            bestLength = length;
+            *distance = position - candidate;
+
+            if(length >= niceLength || length == maxLength)
+                break;
+
+        }
+
+    }
+
+    return bestLength;
+
+}
+
+// insertLzPosition
+static void insertLzPosition(const byte *source, int position, int *head, int *previous){
+
+    // Variables necesarias
+    unsigned int hash = getLzHash(source + position);
+
+    previous[position] = head[hash];
+    head[hash] = position;
+
+}
+
+// addLzSequence
+static void addLzSequence(LzSequence_s *sequences, int *sequencesNumber, int literalsLength, int matchLength, int distance){
+
+    // Variables necesarias
+    int chunkLength = 0;
+
+    // Los literales y las coincidencias que no caben en un código se reparten en varias secuencias
+    // Un trozo de coincidencia nunca deja un resto menor que la coincidencia mínima
+    while(literalsLength > LZ_MAX_VALUE){
+
+        sequences[(*sequencesNumber)++] = (LzSequence_s){LZ_MAX_VALUE, 0, 0};
+        literalsLength -= LZ_MAX_VALUE;
+
+    }
+
+    while(matchLength > LZ_MAX_MATCH_LENGTH){
+
+        chunkLength = (matchLength - LZ_MAX_MATCH_LENGTH >= LZ_MIN_MATCH_LENGTH) ? LZ_MAX_MATCH_LENGTH : matchLength - LZ_MIN_MATCH_LENGTH;
+        sequences[(*sequencesNumber)++] = (LzSequence_s){literalsLength, chunkLength, distance};
+        literalsLength = 0;
+        matchLength -= chunkLength;
+
+    }
+
+    if(literalsLength > 0 || matchLength > 0)
+        sequences[(*sequencesNumber)++] = (LzSequence_s){literalsLength, matchLength, distance};
+
+}
+
+// getLzHash
+static inline unsigned int getLzHash(const byte *content){
+
+    return ((((unsigned int)content[0] << 16) | ((unsigned int)content[1] << 8) | content[2]) * 2654435761U) >> (32 - LZ_HASH_BITS);
+
+}
+
+// getLzValueCode
+static inline int getLzValueCode(int value, int *extraBits){
+
+    // Variables necesarias
+    int highestBit = 0;
+
+    // Los valores pequeños son su propio código y los demás usan un código por potencia de 2 con el resto en bits extra
+    if(value < LZ_DIRECT_VALUES){
+
+        *extraBits = 0;
+        return value;
+
+    }
+
+    highestBit = 31 - __builtin_clz(value);
+    *extraBits = highestBit;
+
+    return highestBit + LZ_VALUE_EXTRA_BASE;
+
+}
+
+// getLzDistanceCode
+static inline int getLzDistanceCode(int distance, int *extraBits){
+
+    // Variables necesarias
+    int highestBit = 0;
+
+    // Como en Deflate: dos códigos por potencia de 2 (El bit siguiente al más alto elige entre ellos) y el resto en bits extra
+    distance--;
+
+    if(distance < LZ_DIRECT_DISTANCES){
+
+        *extraBits = 0;
+        return distance;
+
+    }
+
+    highestBit = 31 - __builtin_clz(distance);
+    *extraBits = highestBit - 1;
+
+    return 2 * highestBit + ((distance >> (highestBit - 1)) & 1);
+
+}
+
+// loadLzTables
+static int loadLzTables(HuffmanDecoder_s *decoder, const byte *buffer, int length){
+
+    // Variables necesarias
+    int position = 0;
+    int tableLength = 0;
+    int status = 0;
+    int codesMaxLength = 0;
+
+    // Las tres tablas son cabeceras de longitudes normales seguidas: secuencias, literales y distancias
+    for(int i = 0; i < LZ_TABLES_NUMBER; i++){
+
+        tableLength = getCodeLengthsHeaderLength(buffer + position, length - position);
+
+        if(tableLength < 0 || buffer[position + CODE_LENGTHS_HEADER_START - 1] == 0 || tableLength > length - position)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        if((status = unpackCodeLengths(buffer + position, decoder->codeLengths)) < 0)
+            return status;
+
+        if((status = buildTreeFromCodeLengths(decoder->codeLengths, &decoder->huffmanTree)) < 0)
+            return status;
+
+        if(buildDecodeTable(&decoder->huffmanTree, &decoder->lzDecodeTables[i]) < 0)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        for(int j = 0; j < SYMBOLS_NUMBER; j++){
+
+            if(decoder->codeLengths[j] > codesMaxLength)
+                codesMaxLength = decoder->codeLengths[j];
+
+            if(i == LZ_DISTANCES_TABLE && j >= LZ_DISTANCE_CODES_NUMBER && decoder->codeLengths[j] > 0)
+                return HUFFMAN_ERROR_CORRUPT;
+
+        }
+
+        position += tableLength;
+
+    }
+
+    return (position == length) ? codesMaxLength : HUFFMAN_ERROR_CORRUPT;
+
+}
+
+// decodeLzBlock
+static int decodeLzBlock(const byte *encodedContent, int encodedLength, int charactersNumber, DecodeTable_s *lzTables, byte *decodedContent){
+
+    // Variables necesarias
+    BitReader_s bitReader;
+    int position = 0;
+    int token = 0;
+    int literalsLength = 0;
+    int matchLength = 0;
+    int distance = 0;
+    int code = 0;
+
+    initBitReader(&bitReader, encodedContent, encodedLength);
+
+    while(position < charactersNumber){
+
+        // Longitud de los literales y de la coincidencia a partir de sus códigos en el símbolo de la secuencia
+        token = decodeSymbol(&bitReader, &lzTables[LZ_TOKENS_TABLE]);
+        literalsLength = token >> 4;
+        matchLength = token & 0x0F;
+
+        if(literalsLength >= LZ_DIRECT_VALUES)
+            literalsLength = (1 << (literalsLength - LZ_VALUE_EXTRA_BASE)) + (int)readBits(&bitReader, literalsLength - LZ_VALUE_EXTRA_BASE);
+
+        if(literalsLength > charactersNumber - position || (literalsLength == 0 && matchLength == 0))
+            return HUFFMAN_ERROR_CORRUPT;
+
+        for(int i = 0; i < literalsLength; i++)
+            decodedContent[position + i] = decodeSymbol(&bitReader, &lzTables[LZ_LITERALS_TABLE]);
+
+        position += literalsLength;
+
+        if(matchLength == 0)
+            continue;
+
+        if(matchLength >= LZ_DIRECT_VALUES)
+            matchLength = (1 << (matchLength - LZ_VALUE_EXTRA_BASE)) + (int)readBits(&bitReader, matchLength - LZ_VALUE_EXTRA_BASE);
+
+        matchLength += LZ_MIN_MATCH_LENGTH - 1;
+
+        // Distancia a partir de su código y sus bits extra
+        code = decodeSymbol(&bitReader, &lzTables[LZ_DISTANCES_TABLE]);
+        distance = (code < LZ_DIRECT_DISTANCES) ? code : ((2 | (code & 1)) << (code / 2 - 1)) + (int)readBits(&bitReader, code / 2 - 1);
+        distance++;
+
+        if(distance > position || matchLength > charactersNumber - position)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        // Si la coincidencia se solapa con lo que copia hay que copiar byte a byte
+        if(distance >= matchLength)
+            memcpy(decodedContent + position, decodedContent + position - distance, matchLength);
+        else
+            for(int i = 0; i < matchLength; i++)
+                decodedContent[position + i] = decodedContent[position + i - distance];
+
+        position += matchLength;
+
+    }
+
+    return 0;
+
+}
+
+// readBits
+static inline unsigned int readBits(BitReader_s *bitReader, int bitsNumber){
+
+    // Variables necesarias
+    unsigned int value = 0;
+
+    // Los bits extra no superan los de un código, así que basta la misma recarga que al descifrar un símbolo
+    if(bitsNumber == 0)
+        return 0;
+
+    if(bitReader->bitsAvailable < bitsNumber)
+        refillBitReader(bitReader);
+
+    value = bitReader->bitBuffer >> (BIT_BUFFER_BITS - bitsNumber);
+    bitReader->bitBuffer <<= bitsNumber;
+    bitReader->bitsAvailable -= bitsNumber;
+
+    return value;
+
+}
+
+// encodeTransformedBlock
+static long long encodeTransformedBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    const byte *stageInput = source;
+    int stageLength = sourceLength;
+    byte *stageOutput = NULL;
+    int outputLength = 0;
+    unsigned int parameter = 0;
+    int transformsChain = 0;
+    int appliedNumber = 0;
+    int position = 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START;
+    long long innerLength = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(capacity < TRANSFORM_FRAME_MAX)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    if(reserveEncoderTransforms(encoder, sourceLength) < 0)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Cada transformación lee la salida de la anterior y escribe en el otro buffer del contexto
+    // Tras la cabecera de longitudes va un registro por transformación aplicada: longitud de su entrada y su parámetro
+    for(int i = 0; i < encoder->transformsNumber; i++){
+
+        stageOutput = encoder->transformBuffers[appliedNumber % 2];
+        outputLength = stageLength;
+        parameter = 0;
+
+        if(encoder->transforms[i] == HUFFMAN_TRANSFORM_RLE)
+            outputLength = encodeRunLengths(stageInput, stageLength, stageOutput);
+        else if(encoder->transforms[i] == HUFFMAN_TRANSFORM_BWT)
+            parameter = encodeBurrowsWheeler(encoder, stageInput, stageLength, stageOutput);
+        else
+            encodeMoveToFront(stageInput, stageLength, stageOutput);
+
+        // Si las repeticiones alargarían el bloque nos saltamos esa transformación en este bloque
+        if(outputLength < 0)
+            continue;
+
+        storeUInt32(destination + position, stageLength);
+        storeUInt32(destination + position + sizeof(unsigned int), parameter);
+        position += TRANSFORM_RECORD_LENGTH;
+
+        transformsChain |= encoder->transforms[i] << (appliedNumber * TRANSFORM_BITS);
+        appliedNumber++;
+
+        stageInput = stageOutput;
+        stageLength = outputLength;
+
+    }
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.transform, &encoder->stats->cpuTimes.transform);
+
+    if(appliedNumber == 0)
+        return encodeEntropyBlock(encoder, source, sourceLength, destination, capacity);
+
+    // Ciframos el resultado como un bloque normal tras los registros
+    innerLength = encodeEntropyBlock(encoder, stageInput, stageLength, destination + position, capacity - position);
+
+    if(innerLength < 0)
+        return innerLength;
+
+    // Cantidad de caracteres original, la marca de bloque transformado con la cadena y la longitud de los registros y el bloque
+    storeUInt32(destination, sourceLength);
+    destination[sizeof(unsigned int)] = 0;
+    destination[sizeof(unsigned int) + 1] = 0;
+    destination[sizeof(unsigned int) + 2] = transformsChain & 0xFF;
+    destination[sizeof(unsigned int) + 3] = transformsChain >> BITS_IN_BYTE;
+    destination[sizeof(unsigned int) + 4] = 0;
+    storeUInt32(destination + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START, position - (2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START) + innerLength);
+
+    return position + innerLength;
+
+}
+
+// decodeTransformedBlock
+static long long decodeTransformedBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    long long neededLength = 0;
+    int charactersNumber = 0;
+    int innerCharactersNumber = 0;
+    int transformsChain = 0;
+    int transformsNumber = 0;
+    const byte *records = NULL;
+    const byte *innerFrame = NULL;
+    long long innerLength = 0;
+    int maxLength = 0;
+    int stageLength = 0;
+    int outputLength = 0;
+    byte *stageInput = NULL;
+    byte *stageOutput = NULL;
+    long long status = 0;
+    HuffmanStageClock_s stageClock;
+
+    neededLength = huffmanGetBlockFrameLength(frame, frameLength, &charactersNumber);
+
+    if(neededLength < 0)
+        return neededLength;
+
+    if(neededLength == 0 || (loadUInt32(frame) & MULTI_STREAM_FLAG))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if((size_t)neededLength > frameLength)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if((size_t)charactersNumber > capacity || destination == NULL)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    // La cadena ya se validó al leer la cabecera, así que solo contamos sus transformaciones
+    transformsChain = frame[sizeof(unsigned int) + 2] | (frame[sizeof(unsigned int) + 3] << BITS_IN_BYTE);
+
+    for(int chain = transformsChain; chain != 0; chain >>= TRANSFORM_BITS)
+        transformsNumber++;
+
+    // Tras los registros va un bloque normal completo (Nunca otro bloque transformado)
+    records = frame + 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START;
+    innerFrame = records + transformsNumber * TRANSFORM_RECORD_LENGTH;
+    innerLength = neededLength - (innerFrame - frame);
+
+    if(innerLength < (long long)(sizeof(unsigned int) + CODE_LENGTHS_HEADER_START) || isTransformHeader(innerFrame + sizeof(unsigned int)))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if(huffmanGetBlockFrameLength(innerFrame, innerLength, &innerCharactersNumber) != innerLength)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // La primera transformación parte del bloque original y ninguna etapa puede superar el tamaño máximo de bloque
+    if(loadUInt32(records) != (unsigned int)charactersNumber)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    maxLength = innerCharactersNumber;
+
+    for(int i = 0; i < transformsNumber; i++){
+
+        if(loadUInt32(records + i * TRANSFORM_RECORD_LENGTH) > HUFFMAN_MAX_BLOCK_SIZE)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        if((int)loadUInt32(records + i * TRANSFORM_RECORD_LENGTH) > maxLength)
+            maxLength = loadUInt32(records + i * TRANSFORM_RECORD_LENGTH);
+
+    }
+
+    if(reserveDecoderTransforms(decoder, maxLength) < 0)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    // Desciframos el bloque interior en uno de los buffers del contexto
+    if((status = decodeEntropyBlock(decoder, innerFrame, innerLength, decoder->transformBuffers[0], maxLength)) < 0)
+        return status;
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Deshacemos las transformaciones de la última a la primera, la primera escribe directamente en el destino
+    stageInput = decoder->transformBuffers[0];
+    stageLength = innerCharactersNumber;
+
+    for(int i = transformsNumber - 1; i >= 0; i--){
+
+        stageOutput = (i == 0) ? destination : decoder->transformBuffers[(transformsNumber - i) % 2];
+        outputLength = loadUInt32(records + i * TRANSFORM_RECORD_LENGTH);
+
+        switch((transformsChain >> (i * TRANSFORM_BITS)) & TRANSFORM_MASK){
+
+            case HUFFMAN_TRANSFORM_RLE:
+                status = decodeRunLengths(stageInput, stageLength, stageOutput, outputLength);
+                break;
+
+            case HUFFMAN_TRANSFORM_BWT:
+                status = (stageLength == outputLength) ? decodeBurrowsWheeler(stageInput, stageLength, loadUInt32(records + i * TRANSFORM_RECORD_LENGTH + sizeof(unsigned int)), decoder->transformRows, stageOutput) : HUFFMAN_ERROR_CORRUPT;
+                break;
+
+            default:
+                status = (stageLength == outputLength) ? stageLength : HUFFMAN_ERROR_CORRUPT;
+
+                if(status >= 0)
+                    decodeMoveToFront(stageInput, stageLength, stageOutput);
+
+                break;
+
+        }
+
+        if(status != outputLength)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        stageInput = stageOutput;
+        stageLength = outputLength;
+
+    }
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &decoder->stats->wallTimes.transform, &decoder->stats->cpuTimes.transform);
+
+    return charactersNumber;
+
+}
+
+// isTransformHeader
+static int isTransformHeader(const byte *buffer){
+
+    // Primer símbolo y bits por longitud a 0 con una cadena de transformaciones en el último símbolo
+    return buffer[0] == 0 && buffer[1] == 0 && (buffer[2] != 0 || buffer[3] != 0) && buffer[4] == 0;
+
+}
+
+// reserveEncoderTransforms
+static int reserveEncoderTransforms(HuffmanEncoder_s *encoder, int length){
+
+    // Los buffers crecen hasta el bloque más largo y se reutilizan en los siguientes
+    // El vector de sufijos necesita un entero por byte y SA-IS otros dos por byte para las cubetas y los tipos de sus niveles (Las del primero van aparte)
+    if(length <= encoder->transformCapacity)
+        return 0;
+
+    free(encoder->transformBuffers[0]);
+    free(encoder->transformBuffers[1]);
+    free(encoder->suffixArray);
+    free(encoder->suffixRanks);
+    free(encoder->suffixTemp);
+    free(encoder->suffixCounts);
+
+    encoder->transformBuffers[0] = (byte*)malloc(length);
+    encoder->transformBuffers[1] = (byte*)malloc(length);
+    encoder->suffixArray = (int*)malloc((size_t)length * sizeof(int));
+    encoder->suffixRanks = (int*)malloc((size_t)length * sizeof(int));
+    encoder->suffixTemp = (int*)malloc((size_t)length * sizeof(int));
+    encoder->suffixCounts = (int*)malloc(SYMBOLS_NUMBER * sizeof(int));
+    encoder->transformCapacity = length;
+
+    if(encoder->stats != NULL)
+        encoder->stats->allocationsNumber += 6;
+
+    if(encoder->transformBuffers[0] == NULL || encoder->transformBuffers[1] == NULL || encoder->suffixArray == NULL ||
+       encoder->suffixRanks == NULL || encoder->suffixTemp == NULL || encoder->suffixCounts == NULL){
+
+        encoder->transformCapacity = 0;
+        return HUFFMAN_ERROR_CAPACITY;
+
+    }
+
+    return 0;
+
+}
+
+// reserveDecoderTransforms
+static int reserveDecoderTransforms(HuffmanDecoder_s *decoder, int length){
+
+    // Dos buffers para las etapas intermedias y una fila siguiente por cada fila de la matriz de la BWT (Una más que bytes)
+    if(length <= decoder->transformCapacity)
+        return 0;
+
+    free(decoder->transformBuffers[0]);
+    free(decoder->transformBuffers[1]);
+    free(decoder->transformRows);
+
+    decoder->transformBuffers[0] = (byte*)malloc(length);
+    decoder->transformBuffers[1] = (byte*)malloc(length);
+    decoder->transformRows = (unsigned long long*)malloc(((size_t)length + 1) * sizeof(unsigned long long));
+    decoder->transformCapacity = length;
+
+    if(decoder->stats != NULL)
+        decoder->stats->allocationsNumber += 3;
+
+    if(decoder->transformBuffers[0] == NULL || decoder->transformBuffers[1] == NULL || decoder->transformRows == NULL){
+
+        decoder->transformCapacity = 0;
+        return HUFFMAN_ERROR_CAPACITY;
+
+    }
+
+    return 0;
+
+}
+
+// encodeRunLengths
+static int encodeRunLengths(const byte *source, int sourceLength, byte *destination){
+
+    // Variables necesarias
+    int position = 0;
+    int runLength = 0;
+
+    // Cada racha de 4 bytes iguales o más se guarda como 4 bytes y las repeticiones que faltan (Hasta 255)
+    // Si el resultado fuera más largo que la entrada devolvemos -1 y el bloque se cifra sin esta transformación
+    for(int i = 0; i < sourceLength; i += runLength){
+
+        runLength = 1;
+
+        while(i + runLength < sourceLength && runLength < RLE_RUN_LENGTH + RLE_MAX_EXTRA_LENGTH && source[i + runLength] == source[i])
+            runLength++;
+
+        if(runLength >= RLE_RUN_LENGTH){
+
+            if(position + RLE_RUN_LENGTH + 1 > sourceLength)
+                return -1;
+
+            memset(destination + position, source[i], RLE_RUN_LENGTH);
+            destination[position + RLE_RUN_LENGTH] = runLength - RLE_RUN_LENGTH;
+            position += RLE_RUN_LENGTH + 1;
+
+        }
+        else{
+
+            if(position + runLength > sourceLength)
+                return -1;
+
+            memset(destination + position, source[i], runLength);
+            position += runLength;
+
+        }
+
+    }
+
+    return position;
+
+}
+
+// decodeRunLengths
+static int decodeRunLengths(const byte *source, int sourceLength, byte *destination, int capacity){
+
+    // Variables necesarias
+    int position = 0;
+    int runLength = 0;
+    byte previous = 0;
+
+    // Tras 4 bytes iguales seguidos el siguiente byte es el número de repeticiones que faltan
+    for(int i = 0; i < sourceLength; i++){
+
+        if(runLength == RLE_RUN_LENGTH){
+
+            if(source[i] > capacity - position)
+                return HUFFMAN_ERROR_CORRUPT;
+
+            memset(destination + position, previous, source[i]);
+            position += source[i];
+            runLength = 0;
+
+            continue;
+
+        }
+
+        if(position == capacity)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        runLength = (runLength > 0 && source[i] == previous) ? runLength + 1 : 1;
+        previous = source[i];
+        destination[position++] = source[i];
+
+    }
+
+    return (runLength == RLE_RUN_LENGTH) ? HUFFMAN_ERROR_CORRUPT : position;
+
+}
+
+// encodeBurrowsWheeler
+static unsigned int encodeBurrowsWheeler(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination){
+
+    // Variables necesarias
+    unsigned int primaryIndex = 0;
+    int position = 1;
+
+    buildSuffixArray(source, sourceLength, encoder->suffixArray, encoder->suffixRanks, encoder->suffixTemp, encoder->suffixCounts);
+
+    // Ordenamos los sufijos con un final más pequeño que cualquier byte, así que la primera fila es el sufijo vacío
+    // La salida es el byte anterior a cada sufijo salvo el del sufijo completo, cuya fila es el índice primario
+    destination[0] = source[sourceLength - 1];
+
+    for(int i = 0; i < sourceLength; i++){
+
+        if(encoder->suffixArray[i] == 0)
+            primaryIndex = i + 1;
+        else
+            destination[position++] = source[encoder->suffixArray[i] - 1];
+
+    }
+
+    return primaryIndex;
+
+}
+
+// decodeBurrowsWheeler
+static int decodeBurrowsWheeler(const byte *source, int sourceLength, unsigned int primaryIndex, unsigned long long *nextRows, byte *destination){
+
+    // Variables necesarias
+    int symbolStarts[SYMBOLS_NUMBER] = {0};
+    int symbolsBefore = 1;
+    int symbolCount = 0;
+    unsigned long long row = primaryIndex;
+    byte symbol = 0;
+
+    if(primaryIndex < 1 || primaryIndex > (unsigned int)sourceLength)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Las filas que empiezan por cada byte van tras la del sufijo vacío y las de los bytes menores
+    for(int i = 0; i < sourceLength; i++)
+        symbolStarts[source[i]]++;
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        symbolCount = symbolStarts[i];
+        symbolStarts[i] = symbolsBefore;
+        symbolsBefore += symbolCount;
+
+    }
+
+    // Cada fila guarda su primer byte y la fila que sigue al quitárselo, así recorrer el bloque es una lectura por byte
+    // (La fila del índice primario no tiene byte anterior y la del sufijo vacío no tiene siguiente)
+    for(int i = 0; i <= sourceLength; i++){
+
+        if(i == (int)primaryIndex)
+            continue;
+
+        symbol = (i < (int)primaryIndex) ? source[i] : source[i - 1];
+        nextRows[symbolStarts[symbol]++] = ((unsigned long long)i << BITS_IN_BYTE) | symbol;
+
+    }
+
+    // Partiendo del bloque completo (La fila del índice primario) recuperamos el bloque del primer byte al último
+    for(int i = 0; i < sourceLength; i++){
+
+        if(row == 0)
+            return HUFFMAN_ERROR_CORRUPT;
+
+        destination[i] = nextRows[row] & 0xFF;
+        row = nextRows[row] >> BITS_IN_BYTE;
+
+    }
+
+    return (row == 0) ? sourceLength : HUFFMAN_ERROR_CORRUPT;
+
+}
+
+// buildSuffixArray
+static void buildSuffixArray(const byte *content, int length, int *suffixArray, int *ranks, int *temp, int *counts){
+
+    // SA-IS (Nong, Zhang y Chan): tiempo lineal, el bloque entero se ordena en unas pocas pasadas sea cual sea su contenido
+    // Los tipos de cada nivel van en temp como bytes y las cubetas del primer nivel en counts, las de los siguientes en ranks
+    // (Cada nivel tiene como mucho la mitad de símbolos que el anterior, así que todo cabe en los buffers del contexto)
+    sortSuffixes(content, sizeof(byte), length, SYMBOLS_NUMBER, suffixArray, (byte*)temp, counts, ranks);
+
+}
+
+// sortSuffixes
+static void sortSuffixes(const void *content, int symbolSize, int length, int alphabetSize, int *suffixArray, byte *types, int *buckets, int *nextBuckets){
+
+    // Variables necesarias
+    int reducedLength = 0;
+    int namesNumber = 0;
+    int previous = -1;
+    int position = 0;
+    int different = 0;
+    int *reducedContent = NULL;
+
+    if(length <= 1){
+
+        if(length == 1)
+            suffixArray[0] = 0;
+
+        return;
+
+    }
+
+    // Tipo de cada sufijo: S si es menor que el siguiente y L si es mayor (Tras el último va un final menor que cualquier símbolo)
+    types[length - 1] = 0;
+
+    for(int i = length - 2; i >= 0; i--)
+        types[i] = SUFFIX_SYMBOL(content, symbolSize, i) < SUFFIX_SYMBOL(content, symbolSize, i + 1) ||
+                   (SUFFIX_SYMBOL(content, symbolSize, i) == SUFFIX_SYMBOL(content, symbolSize, i + 1) && types[i + 1]);
+
+    // Colocamos los sufijos LMS (S tras un L) al final de sus cubetas e inducimos el resto, así quedan ordenadas sus subcadenas
+    getSuffixBuckets(content, symbolSize, length, alphabetSize, buckets, 1);
+
+    for(int i = 0; i < length; i++)
+        suffixArray[i] = -1;
+
+    for(int i = length - 1; i > 0; i--)
+        if(SUFFIX_IS_LMS(types, i))
+            suffixArray[--buckets[SUFFIX_SYMBOL(content, symbolSize, i)]] = i;
+
+    induceSuffixes(content, symbolSize, length, alphabetSize, suffixArray, types, buckets);
+
+    // Juntamos los LMS ya ordenados al principio y damos el mismo nombre a los que tienen la misma subcadena
+    for(int i = 0; i < length; i++)
+        if(SUFFIX_IS_LMS(types, suffixArray[i]))
+            suffixArray[reducedLength++] = suffixArray[i];
+
+    for(int i = reducedLength; i < length; i++)
+        suffixArray[i] = -1;
+
+    for(int i = 0; i < reducedLength; i++){
+
+        position = suffixArray[i];
+        different = (previous < 0);
+
+        // La subcadena que llega al final es única, porque el final solo aparece una vez
+        for(int j = 0; !different; j++){
+
+            if(position + j == length || previous + j == length ||
+               SUFFIX_SYMBOL(content, symbolSize, position + j) != SUFFIX_SYMBOL(content, symbolSize, previous + j) || types[position + j] != types[previous + j])
+                different = 1;
+            else if(j > 0 && (SUFFIX_IS_LMS(types, position + j) || SUFFIX_IS_LMS(types, previous + j)))
+                break;
+
+        }
+
+        if(different){
+
+            namesNumber++;
+            previous = position;
+
+        }
+
+        // Dos LMS están al menos a dos posiciones, así que cada uno tiene su propio hueco en la segunda mitad
+        suffixArray[reducedLength + position / 2] = namesNumber - 1;
+
+    }
+
+    // La cadena reducida son los nombres en el orden del bloque, al final del vector de sufijos
+    for(int i = length - 1, j = length - 1; i >= reducedLength; i--)
+        if(suffixArray[i] >= 0)
+            suffixArray[j--] = suffixArray[i];
+
+    reducedContent = suffixArray + length - reducedLength;
+
+    // Si hay nombres repetidos ordenamos la cadena reducida de la misma forma, si no su orden sale directamente de los nombres
+    if(namesNumber < reducedLength)
+        sortSuffixes(reducedContent, sizeof(int), reducedLength, namesNumber, suffixArray, types + length, nextBuckets, nextBuckets + namesNumber);
+    else
+        for(int i = 0; i < reducedLength; i++)
+            suffixArray[reducedContent[i]] = i;
+
+    // Con los LMS en su orden definitivo volvemos a inducir el resto de sufijos
+    for(int i = 1, j = 0; i < length; i++)
+        if(SUFFIX_IS_LMS(types, i))
+            reducedContent[j++] = i;
+
+    for(int i = 0; i < reducedLength; i++)
+        suffixArray[i] = reducedContent[suffixArray[i]];
+
+    for(int i = reducedLength; i < length; i++)
+        suffixArray[i] = -1;
+
+    getSuffixBuckets(content, symbolSize, length, alphabetSize, buckets, 1);
+
+    for(int i = reducedLength - 1; i >= 0; i--){
+
+        position = suffixArray[i];
+        suffixArray[i] = -1;
+        suffixArray[--buckets[SUFFIX_SYMBOL(content, symbolSize, position)]] = position;
+
+    }
+
+    induceSuffixes(content, symbolSize, length, alphabetSize, suffixArray, types, buckets);
+
+}
+
+// induceSuffixes
+static void induceSuffixes(const void *content, int symbolSize, int length, int alphabetSize, int *suffixArray, const byte *types, int *buckets){
+
+    // Variables necesarias
+    int previous = 0;
+
+    // Los L se colocan al principio de sus cubetas de izquierda a derecha, empezando por el último sufijo (Que va tras el final)
+    getSuffixBuckets(content, symbolSize, length, alphabetSize, buckets, 0);
+    suffixArray[buckets[SUFFIX_SYMBOL(content, symbolSize, length - 1)]++] = length - 1;
+
+    for(int i = 0; i < length; i++){
+
+        previous = suffixArray[i] - 1;
+
+        if(previous >= 0 && !types[previous])
+            suffixArray[buckets[SUFFIX_SYMBOL(content, symbolSize, previous)]++] = previous;
+
+    }
+
+    // Los S se colocan al final de sus cubetas de derecha a izquierda
+    getSuffixBuckets(content, symbolSize, length, alphabetSize, buckets, 1);
+
+    for(int i = length - 1; i >= 0; i--){
+
+        previous = suffixArray[i] - 1;
+
+        if(previous >= 0 && types[previous])
+            suffixArray[--buckets[SUFFIX_SYMBOL(content, symbolSize, previous)]] = previous;
+
+    }
+
+}
+
+// getSuffixBuckets
+static void getSuffixBuckets(const void *content, int symbolSize, int length, int alphabetSize, int *buckets, int bucketEnds){
+
+    // Variables necesarias
+    int total = 0;
+    int count = 0;
+
+    // Cada símbolo tiene una cubeta en el vector de sufijos, se devuelve su principio o su final
+    memset(buckets, 0, alphabetSize * sizeof(int));
+
+    for(int i = 0; i < length; i++)
+        buckets[SUFFIX_SYMBOL(content, symbolSize, i)]++;
+
+    for(int i = 0; i < alphabetSize; i++){
+
+        count = buckets[i];
+        total += count;
+        buckets[i] = bucketEnds ? total : total - count;
+
+    }
+
+}
+
+// encodeMoveToFront
+static void encodeMoveToFront(const byte *source, int sourceLength, byte *destination){
+
+    // Variables necesarias
+    byte symbols[SYMBOLS_NUMBER];
+    int symbolPosition = 0;
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        symbols[i] = i;
+
+    // Cada byte se sustituye por su posición en la lista y pasa al principio, así las repeticiones cercanas dan valores pequeños
+    for(int i = 0; i < sourceLength; i++){
+
+        for(symbolPosition = 0; symbols[symbolPosition] != source[i]; symbolPosition++);
+
+        destination[i] = symbolPosition;
+        memmove(symbols + 1, symbols, symbolPosition);
+        symbols[0] = source[i];
+
+    }
+
+}
+
+// decodeMoveToFront
+static void decodeMoveToFront(const byte *source, int sourceLength, byte *destination){
+
+    // Variables necesarias
+    byte symbols[SYMBOLS_NUMBER];
+    byte symbol = 0;
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        symbols[i] = i;
+
+    for(int i = 0; i < sourceLength; i++){
+
+        symbol = symbols[source[i]];
+        destination[i] = symbol;
+        memmove(symbols + 1, symbols, source[i]);
+        symbols[0] = symbol;
+
+    }
+
+}
+
+// encodeCheckpointBlock
+static long long encodeCheckpointBlock(HuffmanEncoder_s *encoder, const byte *source, int sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    int interval = encoder->checkpointInterval;
+    int checkpointsNumber = (sourceLength + interval - 1) / interval;
+    size_t position = CHECKPOINT_FRAME_START + (size_t)checkpointsNumber * CHECKPOINT_RECORD_LENGTH;
+    int lzLevel = encoder->lzLevel;
+    int streamsNumber = encoder->streamsNumber;
+    const byte *innerFrame = NULL;
+    const byte *contextBitmap = NULL;
+    HuffmanCode_s *contextCodes[SYMBOLS_NUMBER];
+    byte *record = NULL;
+    long long innerLength = 0;
+    unsigned long long bitOffset = 0;
+    byte previous = 0;
+    HuffmanStageClock_s stageClock;
+
+    if(capacity < position)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    // Para poder empezar a descifrar en cualquier punto el bloque va en un único flujo y sin coincidencias de LZ77
+    encoder->lzLevel = 0;
+    encoder->streamsNumber = 1;
+    innerLength = encodeEntropyBlock(encoder, source, sourceLength, destination + position, capacity - position);
+    encoder->lzLevel = lzLevel;
+    encoder->streamsNumber = streamsNumber;
+
+    if(innerLength < 0)
+        return innerLength;
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Tabla con la que se cifró cada byte según el anterior: en un bloque de orden 1 la de su contexto (Las que no están
+    // en el mapa de bits usan la compartida), con una tabla estática la estática y si no la del bloque
+    innerFrame = destination + position;
+    contextBitmap = innerFrame + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START + sizeof(unsigned int);
+
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        if(innerFrame[sizeof(unsigned int) + CODE_LENGTHS_HEADER_START - 1] != 0)
+            contextCodes[i] = encoder->huffmanCodes;
+        else if(innerFrame[sizeof(unsigned int)] != 0)
+            contextCodes[i] = encoder->staticCodes;
+        else if(contextBitmap[i / BITS_IN_BYTE] & (0x80 >> (i % BITS_IN_BYTE)))
+            contextCodes[i] = encoder->contextCodes + (size_t)i * SYMBOLS_NUMBER;
+        else
+            contextCodes[i] = encoder->contextCodes + (size_t)SYMBOLS_NUMBER * SYMBOLS_NUMBER;
+
+    }
+
+    // Cada punto de acceso guarda en cuántos bits del contenido del bloque interior empieza su tramo y el byte anterior,
+    // que en un bloque de orden 1 es el que elige la tabla con la que se sigue descifrando
+    for(int i = 0; i < checkpointsNumber; i++){
+
+        record = destination + CHECKPOINT_FRAME_START + (size_t)i * CHECKPOINT_RECORD_LENGTH;
+        storeUInt64(record, bitOffset);
+        record[sizeof(unsigned long long)] = previous;
+
+        for(int j = i * interval; j < sourceLength && j < (i + 1) * interval; j++){
+
+            bitOffset += contextCodes[previous][source[j]].codeLength;
+            previous = source[j];
+
+        }
+
+    }
+
+    // Cantidad de caracteres, la marca de puntos de acceso (Primer símbolo 257), la longitud del resto y el intervalo
+    storeUInt32(destination, sourceLength);
+    memset(destination + sizeof(unsigned int), 0, CODE_LENGTHS_HEADER_START);
+    destination[sizeof(unsigned int)] = CHECKPOINT_BLOCK_MARKER & 0xFF;
+    destination[sizeof(unsigned int) + 1] = CHECKPOINT_BLOCK_MARKER >> BITS_IN_BYTE;
+    storeUInt32(destination + sizeof(unsigned int) + CODE_LENGTHS_HEADER_START, position - (2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START) + innerLength);
+    storeUInt32(destination + 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START, interval);
+
+    if(encoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &encoder->stats->wallTimes.encode, &encoder->stats->cpuTimes.encode);
+
+    return position + innerLength;
+
+}
+
+// decodeCheckpointBlock
+static long long decodeCheckpointBlock(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    const byte *innerFrame = NULL;
+    long long innerLength = 0;
+    int interval = 0;
+
+    if((innerLength = getCheckpointInnerFrame(frame, frameLength, &interval, &innerFrame)) < 0)
+        return innerLength;
+
+    return decodeEntropyBlock(decoder, innerFrame, innerLength, destination, capacity);
+
+}
+
+// getCheckpointInnerFrame
+static long long getCheckpointInnerFrame(const byte *frame, size_t frameLength, int *interval, const byte **innerFrame){
+
+    // Variables necesarias
+    long long neededLength = 0;
+    long long innerLength = 0;
+    long long checkpointsNumber = 0;
+    int charactersNumber = 0;
+    int innerCharactersNumber = 0;
+    const byte *innerHeader = NULL;
+
+    neededLength = huffmanGetBlockFrameLength(frame, frameLength, &charactersNumber);
+
+    if(neededLength < 0)
+        return neededLength;
+
+    if(neededLength == 0 || (loadUInt32(frame) & MULTI_STREAM_FLAG))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if((size_t)neededLength > frameLength)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    if(neededLength < (long long)CHECKPOINT_FRAME_START)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Hay un punto de acceso por cada intervalo del bloque, empezando por el primer byte
+    *interval = loadUInt32(frame + 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_START);
+
+    if(*interval <= 0)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    checkpointsNumber = ((long long)charactersNumber + *interval - 1) / *interval;
+    *innerFrame = frame + CHECKPOINT_FRAME_START + checkpointsNumber * CHECKPOINT_RECORD_LENGTH;
+    innerLength = neededLength - (*innerFrame - frame);
+
+    if(innerLength < (long long)(sizeof(unsigned int) + CODE_LENGTHS_HEADER_START))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // Detrás va un bloque en un único flujo que se puede empezar en cualquier punto: normal, con tabla estática o de orden 1
+    innerHeader = *innerFrame + sizeof(unsigned int);
+
+    if(isTransformHeader(innerHeader) || isCheckpointHeader(innerHeader) || (loadUInt32(*innerFrame) & MULTI_STREAM_FLAG) ||
+       (innerHeader[CODE_LENGTHS_HEADER_START - 1] == 0 && (innerHeader[0] | (innerHeader[1] << BITS_IN_BYTE)) == LZ_BLOCK_MARKER))
+        return HUFFMAN_ERROR_CORRUPT;
+
+    if(huffmanGetBlockFrameLength(*innerFrame, innerLength, &innerCharactersNumber) != innerLength || innerCharactersNumber != charactersNumber)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    return innerLength;
+
+}
+
+// decodeBlockRange
+static long long decodeBlockRange(HuffmanDecoder_s *decoder, const byte *frame, size_t frameLength, int offset, int length, byte *destination){
+
+    // Variables necesarias
+    const byte *innerFrame = NULL;
+    const byte *record = NULL;
+    const byte *payload = NULL;
+    long long innerLength = 0;
+    long long payloadLength = 0;
+    long long status = 0;
+    unsigned long long bitOffset = 0;
+    int interval = 0;
+    int headerLength = 0;
+    int charactersNumber = 0;
+    int blockType = 0;
+    int codesMaxLength = 0;
+    DecodeTable_s *decodeTable = NULL;
+    BitReader_s bitReader;
+    byte previous = 0;
+    HuffmanStageClock_s stageClock;
+
+    // Sin puntos de acceso desciframos el bloque entero en el buffer del contexto y copiamos el tramo pedido
+    if(!isCheckpointHeader(frame + sizeof(unsigned int))){
+
+        if((status = huffmanGetBlockFrameLength(frame, frameLength, &charactersNumber)) < 0)
+            return status;
+
+        if(charactersNumber > decoder->rangeCapacity){
+
+            free(decoder->rangeBuffer);
+
+            if((decoder->rangeBuffer = (byte*)malloc(charactersNumber)) == NULL){
+
+                decoder->rangeCapacity = 0;
+                return HUFFMAN_ERROR_CAPACITY;
+
+            }
+
+            decoder->rangeCapacity = charactersNumber;
+
+            if(decoder->stats != NULL)
+                decoder->stats->allocationsNumber++;
+
+        }
+
+        if((status = huffmanDecodeBlock(decoder, frame, frameLength, decoder->rangeBuffer, decoder->rangeCapacity)) < 0)
+            return status;
+
+        memcpy(destination, decoder->rangeBuffer + offset, length);
+
+        return length;
+
+    }
+
+    if((innerLength = getCheckpointInnerFrame(frame, frameLength, &interval, &innerFrame)) < 0)
+        return innerLength;
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, NULL, NULL);
+
+    // Construimos las tablas del bloque interior como para descifrarlo entero
+    headerLength = getCodeLengthsHeaderLength(innerFrame + sizeof(unsigned int), innerLength - sizeof(unsigned int));
+
+    if((blockType = loadBlockTables(decoder, innerFrame, headerLength, &decodeTable, &codesMaxLength)) < 0)
+        return blockType;
+
+    if(decoder->stats != NULL)
+        huffmanMeasureStage(&stageClock, &decoder->stats->wallTimes.decodeTable, &decoder->stats->cpuTimes.decodeTable);
+
+    // Saltamos al punto de acceso anterior al tramo con el byte anterior a ese punto como contexto
+    record = frame + CHECKPOINT_FRAME_START + (size_t)(offset / interval) * CHECKPOINT_RECORD_LENGTH;
+    bitOffset = loadUInt64(record);
+    previous = record[sizeof(unsigned long long)];
+
+    payload = innerFrame + 2 * sizeof(unsigned int) + headerLength;
+    payloadLength = innerLength - 2 * sizeof(unsigned int) - headerLength;
+
+    if(bitOffset > (unsigned long long)payloadLength * BITS_IN_BYTE)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    initBitReader(&bitReader, payload + bitOffset / BITS_IN_BYTE, payloadLength - bitOffset / BITS_IN_BYTE);
+    readBits(&bitReader, bitOffset % BITS_IN_BYTE);
+
+    // Desciframos desde el punto de acceso y solo guardamos a partir del inicio del tramo
+    for(int i = -(offset % interval); i < length; i++){
+
+        previous = decodeSymbol(&bitReader, (blockType == BLOCK_TYPE_CONTEXT) ? decoder->contextTables[previous] : decodeTable);
+
+        if(i >= 0)
+            destination[i] = previous;
+
+    }
+
+    if(decoder->stats != NULL){
+
+        huffmanMeasureStage(&stageClock, &decoder->stats->wallTimes.decode, &decoder->stats->cpuTimes.decode);
+        decoder->stats->blocksNumber++;
+        decoder->stats->symbolsNumber += length;
+
+    }
+
+    return length;
+
+}
+
+// isCheckpointHeader
+static int isCheckpointHeader(const byte *buffer){
+
+    // Primer símbolo 257 y el resto de la cabecera a 0
+    return buffer[0] == (CHECKPOINT_BLOCK_MARKER & 0xFF) && buffer[1] == (CHECKPOINT_BLOCK_MARKER >> BITS_IN_BYTE) && buffer[2] == 0 && buffer[3] == 0 && buffer[4] == 0;
+
+}
+
+// getBlockIndexEntries
+static long long getBlockIndexEntries(const byte *source, size_t sourceLength, const byte **indexEntries){
+
+    // Variables necesarias
+    unsigned long long indexOffset = 0;
+    unsigned int blocksNumber = 0;
+
+    // La posición del índice está en los últimos bytes del contenedor
+    if(sourceLength < HUFFMAN_CONTAINER_HEADER_LENGTH + 2 * sizeof(unsigned int) + sizeof(unsigned long long))
+        return HUFFMAN_ERROR_FORMAT;
+
+    indexOffset = loadUInt64(source + sourceLength - sizeof(unsigned long long));
+
+    if(indexOffset < HUFFMAN_CONTAINER_HEADER_LENGTH || indexOffset > sourceLength - sizeof(unsigned long long) - 2 * sizeof(unsigned int))
+        return HUFFMAN_ERROR_FORMAT;
+
+    // Comprobamos la marca y el número de bloques (Las entradas las comprueba quien las lee)
+    if(loadUInt32(source + indexOffset) != INDEX_MARKER)
+        return HUFFMAN_ERROR_FORMAT;
+
+    blocksNumber = loadUInt32(source + indexOffset + sizeof(unsigned int));
+
+    if(blocksNumber > INT_MAX - 1 || indexOffset + huffmanBlockIndexLength(blocksNumber) != sourceLength)
+        return HUFFMAN_ERROR_FORMAT;
+
+    *indexEntries = source + indexOffset + 2 * sizeof(unsigned int);
+
+    return blocksNumber;
+
+}
+
+// initBitReader
+static void initBitReader(BitReader_s *bitReader, const byte *content, int length){
+
+    bitReader->position = content;
+    bitReader->end = content + length;
+    bitReader->bitBuffer = 0;
+    bitReader->bitsAvailable = 0;
+
+}
+
+// getFastIterations
+static int getFastIterations(BitReader_s *bitReader){
+
+    // Cada recarga adelanta la posición como mucho lo que consumieron los dos caracteres anteriores,
+    // así que dejando un margen de dos lecturas sabemos cuántas recargas de 8 bytes caben sin pasar del final
+    if(bitReader->end - bitReader->position < (long)FAST_DECODE_MARGIN)
+        return 0;
+
+    return (bitReader->end - bitReader->position - FAST_DECODE_MARGIN) / FAST_DECODE_BYTES;
+
+}
+
+// loadBitReader
+static inline void loadBitReader(BitReader_s *bitReader){
+
+    // Variables necesarias
+    const byte *position = bitReader->position;
+    unsigned long long auxWord = 0;
+
+    // Cargamos 64 bits de una vez y avanzamos solo los bytes que caben enteros en el buffer (El llamador garantiza que hay 8 bytes)
+    // Los bits sueltos del siguiente byte se vuelven a cargar en la próxima recarga en la misma posición, así que no estorban
+    auxWord = ((unsigned long long)position[0] << 56) | ((unsigned long long)position[1] << 48) | ((unsigned long long)position[2] << 40) | ((unsigned long long)position[3] << 32) |
+        ((unsigned long long)position[4] << 24) | ((unsigned long long)position[5] << 16) | ((unsigned long long)position[6] << 8) | (unsigned long long)position[7];
+
+    bitReader->bitBuffer |= auxWord >> bitReader->bitsAvailable;
+    bitReader->position += (unsigned int)(BIT_BUFFER_BITS - 1 - bitReader->bitsAvailable) / BITS_IN_BYTE;
+    bitReader->bitsAvailable |= BIT_BUFFER_BITS - BITS_IN_BYTE;
+
+}
+
+// refillBitReader
+static inline void refillBitReader(BitReader_s *bitReader){
+
+    if(bitReader->end - bitReader->position >= (long)sizeof(unsigned long long))
+        loadBitReader(bitReader);
+    else
+        refillBitReaderTail(bitReader);
+
+}
+
+// refillBitReaderTail
+static void refillBitReaderTail(BitReader_s *bitReader){
+
+    // Cerca del final rellenamos byte a byte (Más allá del final del flujo se rellena con ceros)
+    while(bitReader->bitsAvailable <= BIT_BUFFER_BITS - BITS_IN_BYTE){
+
+        if(bitReader->position < bitReader->end){
+
+            bitReader->bitBuffer |= (unsigned long long)*bitReader->position << (BIT_BUFFER_BITS - BITS_IN_BYTE - bitReader->bitsAvailable);
+            bitReader->position++;
+
+        }
+
+        bitReader->bitsAvailable += BITS_IN_BYTE;
+
+    }
+
+}
+
+// lookupSymbol
+static inline byte lookupSymbol(BitReader_s *bitReader, DecodeTable_s *decodeTable){
+
+    // Variables necesarias
+    int tableBits = decodeTable->primaryBits;
+    DecodeEntry_s decodeEntry;
+
+    // Consultamos la entrada con los bits más significativos del buffer
+    decodeEntry = decodeTable->entries[bitReader->bitBuffer >> (BIT_BUFFER_BITS - tableBits)];
+
+    // Si la entrada enlaza con una subtabla consumimos los bits de este nivel y pasamos a ella
+    while(decodeEntry.isLink){
+
+        bitReader->bitBuffer <<= tableBits;
+        bitReader->bitsAvailable -= tableBits;
+        tableBits = decodeEntry.length;
+        decodeEntry = decodeTable->entries[decodeEntry.value + (bitReader->bitBuffer >> (BIT_BUFFER_BITS - tableBits))];
+
+    }
+
+    // Consumimos los bits del código del carácter
+    bitReader->bitBuffer <<= decodeEntry.length;
+    bitReader->bitsAvailable -= decodeEntry.length;
+
+    return decodeEntry.value;
+
+}
+
+// decodeSymbol
+static inline byte decodeSymbol(BitReader_s *bitReader, DecodeTable_s *decodeTable){
+
+    // Como ningún código supera los MAX_CODE_LENGTH bits basta con rellenar cuando quedan menos
+    if(bitReader->bitsAvailable < MAX_CODE_LENGTH)
+        refillBitReader(bitReader);
+
+    return lookupSymbol(bitReader, decodeTable);
+
+}
+
+// resetAdaptiveModel
+static void resetAdaptiveModel(HuffmanAdaptiveModel_s *model, int maxCodeLength){
+
+    // Empezamos con todos los bytes igual de probables, así todos tienen código desde el principio y ninguna cuenta llega a 0
+    for(int i = 0; i < SYMBOLS_NUMBER; i++)
+        model->symbolCounts[i] = 1;
+
+    model->totalCount = SYMBOLS_NUMBER;
+    model->encoder->maxCodeLength = maxCodeLength;
+    model->rebuildInterval = ADAPTIVE_FIRST_REBUILD_INTERVAL;
+
+    rebuildAdaptiveCodes(model);
+
+}
+
+// rebuildAdaptiveCodes
+static void rebuildAdaptiveCodes(HuffmanAdaptiveModel_s *model){
+
+    // Variables necesarias
+    HuffmanEncoder_s *encoder = model->encoder;
+
+    // Al pasar del máximo reducimos las cuentas a la mitad, así el modelo sigue los cambios de la entrada y las cuentas no desbordan
+    if(model->totalCount > ADAPTIVE_MAX_TOTAL_COUNT){
+
+        model->totalCount = 0;
+
+        for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+            model->symbolCounts[i] = (model->symbolCounts[i] + 1) / 2;
+            model->totalCount += model->symbolCounts[i];
+
+        }
+
+    }
+
+    // Calculamos los códigos canónicos con las cuentas igual que con el histograma de un bloque
+    memcpy(encoder->frequencyTable, model->symbolCounts, sizeof(encoder->frequencyTable));
+    encoder->charactersNumber = sortCharactersByFrequency(encoder->frequencyTable, encoder->sortedCharacters);
+    buildTree(encoder->sortedCharacters, encoder->charactersNumber, &encoder->huffmanTree);
+    initHuffmanCodes(encoder->huffmanCodes);
+    model->codesMaxLength = generateHuffmanCodes(encoder->huffmanCodes, &encoder->huffmanTree);
+
+    if(model->codesMaxLength > encoder->maxCodeLength)
+        model->codesMaxLength = limitCodeLengths(encoder);
+
+    assignCanonicalCodes(encoder->huffmanCodes, model->codesMaxLength);
+    model->hasDecodeTable = 0;
+
+    // Al principio reconstruimos a menudo para aprender rápido y luego cada vez menos, hasta el intervalo máximo
+    model->symbolsUntilRebuild = model->rebuildInterval;
+
+    if(model->rebuildInterval < ADAPTIVE_MAX_REBUILD_INTERVAL)
+        model->rebuildInterval *= 2;
+
+}
+
+// decodeAdaptiveStream
+static long long decodeAdaptiveStream(HuffmanDecoder_s *decoder, const byte *source, size_t sourceLength, byte *destination, size_t capacity){
+
+    // Variables necesarias
+    int maxCodeLength = 0;
+    size_t sourcePosition = 1;
+    size_t decodedLength = 0;
+    long long chunkLength = 0;
+    long long decodedChunkLength = 0;
+    int charactersNumber = 0;
+
+    // El flujo empieza con la longitud máxima de código con la que se cifró
+    if(sourceLength < 1)
+        return HUFFMAN_ERROR_INCOMPLETE;
+
+    maxCodeLength = source[0];
+
+    if(maxCodeLength < HUFFMAN_MIN_CODE_LENGTH_LIMIT || maxCodeLength > HUFFMAN_MAX_CODE_LENGTH_LIMIT)
+        return HUFFMAN_ERROR_CORRUPT;
+
+    // El modelo se guarda en el contexto y se reinicia en cada flujo
+    if(decoder->adaptiveModel == NULL){
+
+        if((decoder->adaptiveModel = huffmanCreateAdaptiveModel(maxCodeLength)) == NULL)
+            return HUFFMAN_ERROR_ARGUMENT;
+
+    }
+    else
+        resetAdaptiveModel(decoder->adaptiveModel, maxCodeLength);
+
+    decoder->adaptiveModel->stats = decoder->stats;
+
+    // Desciframos los trozos hasta el trozo vacío que marca el final
+    while(1){
+
+        chunkLength = huffmanGetAdaptiveChunkLength(source + sourcePosition, sourceLength - sourcePosition, &charactersNumber);
+
+        if(chunkLength < 0)
+            return chunkLength;
+
+        if((size_t)chunkLength > sourceLength - sourcePosition)
+            return HUFFMAN_ERROR_INCOMPLETE;
+
+        decodedChunkLength = huffmanDecodeAdaptiveChunk(decoder->adaptiveModel, source + sourcePosition, chunkLength, destination + decodedLength, capacity - decodedLength);
+
+        if(decodedChunkLength < 0)
+            return decodedChunkLength;
+
+        sourcePosition += chunkLength;
+        decodedLength += decodedChunkLength;
+
+        if(charactersNumber == 0)
+            break;
+
+    }
+
+    return decodedLength;
+
+}
+
+// buildStaticTableTree
+static int buildStaticTableTree(const byte *codeLengths, int maxCodeLength, int *treeCodeLengths, HuffmanTree_s *huffmanTree){
+
+    // Variables necesarias
+    int codesMaxLength = 0;
+
+    // Todos los bytes deben tener código, si no la tabla no serviría para cualquier entrada
+    for(int i = 0; i < SYMBOLS_NUMBER; i++){
+
+        if(codeLengths[i] < 1 || codeLengths[i] > maxCodeLength)
+            return HUFFMAN_ERROR_ARGUMENT;
+
+        treeCodeLengths[i] = codeLengths[i];
+
+        if(treeCodeLengths[i] > codesMaxLength)
+            codesMaxLength = treeCodeLengths[i];
+
+    }
+
+    // Y las longitudes deben formar un código completo
+    if(buildTreeFromCodeLengths(treeCodeLengths, huffmanTree) < 0)
+        return HUFFMAN_ERROR_ARGUMENT;
+
+    return codesMaxLength;
+
+}
+
+// buildDecodeTable
+static int buildDecodeTable(HuffmanTree_s *huffmanTree, DecodeTable_s *decodeTable){
+
+    // La tabla principal indexa los siguientes DECODE_TABLE_BITS bits (O menos si el árbol no es tan profundo)
+    decodeTable->primaryBits = getTreeDepth(huffmanTree, 0);
+
+    if(decodeTable->primaryBits > DECODE_TABLE_BITS)
+        decodeTable->primaryBits = DECODE_TABLE_BITS;
+
+    // La tabla principal va al inicio y las subtablas se añaden detrás según se van necesitando
+    // La memoria de la tabla se conserva entre bloques y solo crece si un bloque necesita más entradas
+    decodeTable->entriesNumber = 0;
+
+    if(reserveDecodeTable(decodeTable, 1 << decodeTable->primaryBits) < 0)
+        return HUFFMAN_ERROR_CAPACITY;
+
+    return fillDecodeTable(decodeTable, 0, decodeTable->primaryBits, huffmanTree, 0);
+
+}
+
+// fillDecodeTable
+static int fillDecodeTable(DecodeTable_s *decodeTable, int tableOffset, int tableBits, HuffmanTree_s *huffmanTree, int node){
+
+    // Variables necesarias
+    TreeNode_s *nodes = huffmanTree->nodes;
+    int currentNode = 0;
+    int steps = 0;
+    int subtableBits = 0;
+    int subtableOffset = 0;
+
+    // Para cada combinación posible de bits recorremos el árbol desde el nodo hasta una hoja o hasta agotar los bits
+    for(int i = 0; i < (1 << tableBits); i++){
+
+        currentNode = node;
+        steps = 0;
+
+        while(steps < tableBits && nodes[currentNode].leftChild != TREE_NO_CHILD){
+
+            if(((i >> (tableBits - steps - 1)) & 0b1) == 0)
+                currentNode = nodes[currentNode].leftChild;
+            else
+                currentNode = nodes[currentNode].rightChild;
+
+            steps++;
+
+        }
+
+        // Si hemos llegado a una hoja la entrada contiene el símbolo y los bits que ocupa su código en este nivel
+        if(nodes[currentNode].leftChild == TREE_NO_CHILD){
+
+            decodeTable->entries[tableOffset + i].value = nodes[currentNode].stringCharacter.character;
+            decodeTable->entries[tableOffset + i].length = steps;
+            decodeTable->entries[tableOffset + i].isLink = 0;
+
+        }
+        // Si el código es más largo creamos una subtabla para el resto del subárbol y enlazamos con ella
+        else{
+
+            subtableBits = getTreeDepth(huffmanTree, currentNode);
+
+            if(subtableBits > DECODE_TABLE_BITS)
+                subtableBits = DECODE_TABLE_BITS;
+
+            subtableOffset = decodeTable->entriesNumber;
+
+            if(reserveDecodeTable(decodeTable, 1 << subtableBits) < 0)
+                return HUFFMAN_ERROR_CAPACITY;
+
+            decodeTable->entries[tableOffset + i].value = subtableOffset;
+            decodeTable->entries[tableOffset + i].length = subtableBits;
+            decodeTable->entries[tableOffset + i].isLink = 1;
+
+            if(fillDecodeTable(decodeTable, subtableOffset, subtableBits, huffmanTree, currentNode) < 0)
+                return HUFFMAN_ERROR_CAPACITY;
+
+        }
+
+    }
+
+    return 0;
+
+}
+
+// reserveDecodeTable
+static int reserveDecodeTable(DecodeTable_s *decodeTable, int entriesNumber){
+
+    // Variables necesarias
+    DecodeEntry_s *entries = NULL;
+    int capacity = decodeTable->capacity;
+
+    // Añadimos las entradas al final de la tabla, ampliándola al doble si no caben
+    if(decodeTable->entriesNumber + entriesNumber > capacity){
+
+        while(capacity < decodeTable->entriesNumber + entriesNumber)
+            capacity = (capacity > 0) ? capacity * 2 : (1 << DECODE_TABLE_BITS);
+
+        // Si no hay memoria la tabla se queda como estaba, así el contexto se puede seguir usando o liberando
+        if((entries = (DecodeEntry_s*)realloc(decodeTable->entries, capacity * sizeof(DecodeEntry_s))) == NULL)
+            return HUFFMAN_ERROR_CAPACITY;
+
+        decodeTable->entries = entries;
+        decodeTable->capacity = capacity;
+
+    }
+
+    decodeTable->entriesNumber += entriesNumber;
+
+    return 0;
+
+}
+
+// freeDecodeTable
+static void freeDecodeTable(DecodeTable_s *decodeTable){
+
+    free(decodeTable->entries);
+
+    decodeTable->entries = NULL;
+    decodeTable->entriesNumber = 0;
+    decodeTable->capacity = 0;
+
+}
+
+// huffmanEncodeBlockBound
+size_t huffmanEncodeBlockBound(int blockLength, int maxCodeLength){
+
+    // Cantidad de caracteres, cabecera de longitudes, longitud del contenido y los bits de todos los códigos más el último volcado
+    // Se reserva también la tabla de saltos y el relleno del mayor número de flujos posible, el bloque que envuelve
+    // a los bloques transformados (Las transformaciones nunca alargan el bloque) y los puntos de acceso con el intervalo más corto
+    return 2 * sizeof(unsigned int) + CODE_LENGTHS_HEADER_MAX + ((size_t)blockLength * maxCodeLength / BITS_IN_BYTE) + sizeof(unsigned int) + 1 + STREAMS_HEADER_MAX + HUFFMAN_MAX_STREAMS_NUMBER + TRANSFORM_FRAME_MAX +
+           CHECKPOINT_FRAME_START + ((size_t)blockLength / HUFFMAN_MIN_CHECKPOINT_INTERVAL + 1) * CHECKPOINT_RECORD_LENGTH;
+
+}
+
+// storeUInt32
+static void storeUInt32(byte *buffer, unsigned int value){
+
+    for(int i = 0; i < (int)sizeof(unsigned int); i++)
+        buffer[i] = value >> (i * BITS_IN_BYTE);
+
+}
+
+// storeUInt64
+static void storeUInt64(byte *buffer, unsigned long long value){
+
+    for(int i = 0; i < (int)sizeof(unsigned long long); i++)
+        buffer[i] = value >> (i * BITS_IN_BYTE);
+
+}
+
+// loadUInt32
+static unsigned int loadUInt32(const byte *buffer){
+
+    // Variables necesarias
+    unsigned int value = 0;
+
+    for(int i = sizeof(unsigned int) - 1; i >= 0; i--)
+        value = (value << BITS_IN_BYTE) | buffer[i];
+
+    return value;
+
+}
+
+// loadUInt64
+static unsigned long long loadUInt64(const byte *buffer){
+
+    // Variables necesarias
+    unsigned long long value = 0;
+
+    for(int i = sizeof(unsigned long long) - 1; i >= 0; i--)
+        value = (value << BITS_IN_BYTE) | buffer[i];
+
+    return value;
+
+}
+
+// addStageTimes
+static void addStageTimes(HuffmanStageTimes_s *total, const HuffmanStageTimes_s *partial){
+
+    total->read += partial->read;
+    total->transform += partial->transform;
+    total->match += partial->match;
+    total->histogram += partial->histogram;
+    total->treeBuild += partial->treeBuild;
+    total->codeGeneration += partial->codeGeneration;
+    total->encode += partial->encode;
+    total->decodeTable += partial->decodeTable;
+    total->decode += partial->decode;
+    total->write += partial->write;
+
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+/*
+    Título: Huffman
+    Nombre: Héctor Paredes Benavides
+    Descripción: Biblioteca para cifrar y descifrar buffers en memoria con el algoritmo de Huffman
+    Fecha: 16/10/2026
+*/
+
+#ifndef HUFFMAN_H
+#define HUFFMAN_H
+
+/* Instrucciones de Preprocesado */
+// Inclusión de bibliotecas externas
+#include <stddef.h>
+
+// Definición de constantes
+#define HUFFMAN_DEFAULT_MAX_CODE_LENGTH 15
+#define HUFFMAN_MIN_CODE_LENGTH_LIMIT 8
+#define HUFFMAN_MAX_CODE_LENGTH_LIMIT 24
+#define HUFFMAN_DEFAULT_BLOCK_SIZE (1024 * 1024)
+#define HUFFMAN_MAX_BLOCK_SIZE (1024 * 1024 * 1024)
+#define HUFFMAN_DEFAULT_STREAMS_NUMBER 1
+#define HUFFMAN_MAX_STREAMS_NUMBER 8
+#define HUFFMAN_MAX_CONTEXT_ORDER 1
+#define HUFFMAN_MAX_TRANSFORMS_NUMBER 4
+#define HUFFMAN_MAX_LZ77_LEVEL 9
+#define HUFFMAN_DEFAULT_WINDOW_BITS 16
+#define HUFFMAN_MIN_WINDOW_BITS 10
+#define HUFFMAN_MAX_WINDOW_BITS 24
+#define HUFFMAN_MIN_CHECKPOINT_INTERVAL 1024
+#define HUFFMAN_CONTAINER_HEADER_LENGTH 14
+#define HUFFMAN_ORIGINAL_SIZE_OFFSET 6
+#define HUFFMAN_UNKNOWN_ORIGINAL_SIZE 0xFFFFFFFFFFFFFFFFULL
+
+// Opciones de la cabecera del contenedor
+#define HUFFMAN_OPTION_ADAPTIVE 0x01
+
+// Transformaciones previas al cifrado (Se aplican a cada bloque en el orden indicado y el descifrado las deshace en orden inverso)
+#define HUFFMAN_TRANSFORM_RLE 1
+#define HUFFMAN_TRANSFORM_BWT 2
+#define HUFFMAN_TRANSFORM_MTF 3
+
+// Tablas estáticas (Las de la biblioteca tienen identificadores bajos y las entrenadas por el usuario a partir de HUFFMAN_FIRST_USER_TABLE_ID)
+#define HUFFMAN_TABLE_TEXT 1
+#define HUFFMAN_TABLE_LOGS 2
+#define HUFFMAN_BUILTIN_TABLES_NUMBER 2
+#define HUFFMAN_FIRST_USER_TABLE_ID 128
+#define HUFFMAN_MAX_TABLE_ID 255
+#define HUFFMAN_SYMBOLS_NUMBER 256
+#define HUFFMAN_STATIC_TABLE_LENGTH (6 + HUFFMAN_SYMBOLS_NUMBER)
+
+// Códigos de error (Las funciones que devuelven una longitud devuelven uno de estos valores negativos si fallan)
+#define HUFFMAN_ERROR_CAPACITY -1
+#define HUFFMAN_ERROR_INCOMPLETE -2
+#define HUFFMAN_ERROR_CORRUPT -3
+#define HUFFMAN_ERROR_FORMAT -4
+#define HUFFMAN_ERROR_VERSION -5
+#define HUFFMAN_ERROR_ARGUMENT -6
+#define HUFFMAN_ERROR_TABLE -7
+
+/* Declaraciones Globales */
+// Estructuras
+// Los contextos guardan las tablas, el árbol y la memoria auxiliar entre llamadas, así que reutilizándolos
+// un bucle de cifrado o descifrado no reserva memoria. Cada contexto solo debe usarse desde un hilo a la vez
+typedef struct HuffmanEncoder_s HuffmanEncoder_s;
+typedef struct HuffmanDecoder_s HuffmanDecoder_s;
+
+// El modelo adaptativo cifra o descifra un flujo de longitud desconocida por trozos, sin guardar tablas en el fichero
+// Cifrado y descifrado deben procesar los mismos trozos en el mismo orden con un modelo recién creado
+typedef struct HuffmanAdaptiveModel_s HuffmanAdaptiveModel_s;
+
+typedef struct HuffmanBlockIndexEntry_s{
+
+    long long compressedOffset;
+    long long decodedOffset;
+
+}HuffmanBlockIndexEntry_s;
+
+// Tiempo acumulado en cada etapa, en segundos (La lectura y la escritura las mide el programa que hace la entrada y salida)
+typedef struct HuffmanStageTimes_s{
+
+    double read;
+    double transform;
+    double match;
+    double histogram;
+    double treeBuild;
+    double codeGeneration;
+    double encode;
+    double decodeTable;
+    double decode;
+    double write;
+
+}HuffmanStageTimes_s;
+
+// Estadísticas acumuladas de los bloques que procesa un contexto (Los bytes de entrada y salida los anota el programa)
+typedef struct HuffmanStats_s{
+
+    HuffmanStageTimes_s wallTimes;
+    HuffmanStageTimes_s cpuTimes;
+    long long blocksNumber;
+    long long symbolsNumber;
+    long long payloadBits;
+    int maxCodeLength;
+    int maxDistinctSymbols;
+    long long allocationsNumber;
+    long long bytesIn;
+    long long bytesOut;
+
+}HuffmanStats_s;
+
+// Instante en el que empezó la etapa actual (Tiempo real y tiempo de CPU del hilo)
+typedef struct HuffmanStageClock_s{
+
+    double wallTime;
+    double cpuTime;
+
+}HuffmanStageClock_s;
+
+// Prototipado de Funciones
+// Funciones de cifrado
+HuffmanEncoder_s* huffmanCreateEncoder(int blockSize, int maxCodeLength, int threadsNumber);
+void huffmanFreeEncoder(HuffmanEncoder_s *encoder);
+size_t huffmanEncodeBound(size_t sourceLength, int blockSize, int maxCodeLength);
+long long huffmanEncode(HuffmanEncoder_s *encoder, const unsigned char *source, size_t sourceLength, unsigned char *destination, size_t capacity);
+size_t huffmanEncodeBlockBound(int blockLength, int maxCodeLength);
+long long huffmanEncodeBlock(HuffmanEncoder_s *encoder, const unsigned char *source, int sourceLength, unsigned char *destination, size_t capacity);
+int huffmanSetEncoderStreams(HuffmanEncoder_s *encoder, int streamsNumber);
+int huffmanSetEncoderContextOrder(HuffmanEncoder_s *encoder, int contextOrder);
+int huffmanSetEncoderTransforms(HuffmanEncoder_s *encoder, const int *transforms, int transformsNumber);
+int huffmanSetEncoderLz77(HuffmanEncoder_s *encoder, int level, int windowBits);
+int huffmanSetEncoderCheckpoints(HuffmanEncoder_s *encoder, int interval);
+
+// Funciones de descifrado
+HuffmanDecoder_s* huffmanCreateDecoder();
+void huffmanFreeDecoder(HuffmanDecoder_s *decoder);
+long long huffmanDecode(HuffmanDecoder_s *decoder, const unsigned char *source, size_t sourceLength, unsigned char *destination, size_t capacity);
+long long huffmanDecodeBlock(HuffmanDecoder_s *decoder, const unsigned char *frame, size_t frameLength, unsigned char *destination, size_t capacity);
+
+// Descifra los bytes [offset, offset + length) de un contenedor completo en memoria buscando los bloques en el índice
+// Los bloques con puntos de acceso se descifran desde el punto anterior a offset y el resto enteros
+long long huffmanDecodeRange(HuffmanDecoder_s *decoder, const unsigned char *source, size_t sourceLength, unsigned long long offset, size_t length, unsigned char *destination);
+
+// Funciones del formato del contenedor
+int huffmanWriteContainerHeader(unsigned char *destination, unsigned long long originalSize, int options);
+long long huffmanReadContainerHeader(const unsigned char *source, size_t sourceLength, unsigned long long *originalSize, int *options);
+long long huffmanGetBlockFrameLength(const unsigned char *source, size_t availableLength, int *charactersNumber);
+size_t huffmanBlockIndexLength(int blocksNumber);
+size_t huffmanWriteBlockIndex(unsigned char *destination, HuffmanBlockIndexEntry_s *entries, int blocksNumber, unsigned long long indexOffset);
+long long huffmanReadBlockIndex(const unsigned char *source, size_t sourceLength, HuffmanBlockIndexEntry_s *entries, int capacity);
+
+// Funciones del modo adaptativo (Un trozo sin caracteres marca el final del flujo)
+HuffmanAdaptiveModel_s* huffmanCreateAdaptiveModel(int maxCodeLength);
+void huffmanFreeAdaptiveModel(HuffmanAdaptiveModel_s *model);
+size_t huffmanAdaptiveChunkBound(int chunkLength, int maxCodeLength);
+long long huffmanEncodeAdaptiveChunk(HuffmanAdaptiveModel_s *model, const unsigned char *source, int sourceLength, unsigned char *destination, size_t capacity);
+long long huffmanGetAdaptiveChunkLength(const unsigned char *source, size_t availableLength, int *charactersNumber);
+long long huffmanDecodeAdaptiveChunk(HuffmanAdaptiveModel_s *model, const unsigned char *frame, size_t frameLength, unsigned char *destination, size_t capacity);
+
+// Funciones de las tablas estáticas (Cada tabla son las longitudes de código de los 256 bytes, todas entre 1 y la longitud máxima)
+// Con una tabla estática el cifrado no calcula el histograma ni el árbol y el bloque solo guarda el identificador de la tabla
+int huffmanBuildStaticTable(const unsigned long long *symbolCounts, int maxCodeLength, unsigned char *codeLengths);
+int huffmanGetBuiltinStaticTable(int tableId, unsigned char *codeLengths);
+int huffmanWriteStaticTable(unsigned char *destination, int tableId, const unsigned char *codeLengths);
+long long huffmanReadStaticTable(const unsigned char *source, size_t sourceLength, int *tableId, unsigned char *codeLengths);
+int huffmanSetEncoderStaticTable(HuffmanEncoder_s *encoder, int tableId, const unsigned char *codeLengths);
+int huffmanAddDecoderStaticTable(HuffmanDecoder_s *decoder, int tableId, const unsigned char *codeLengths);
+
+// Funciones auxiliares
+const char* huffmanErrorMessage(long long errorCode);
+
+// Funciones de estadísticas (Con un puntero a NULL el contexto deja de medir)
+void huffmanSetEncoderStats(HuffmanEncoder_s *encoder, HuffmanStats_s *stats);
+void huffmanSetDecoderStats(HuffmanDecoder_s *decoder, HuffmanStats_s *stats);
+void huffmanSetAdaptiveStats(HuffmanAdaptiveModel_s *model, HuffmanStats_s *stats);
+void huffmanAddStats(HuffmanStats_s *total, const HuffmanStats_s *partial);
+void huffmanMeasureStage(HuffmanStageClock_s *stageClock, double *wallTime, double *cpuTime);
+
+#endif
\ No newline at end of file